@@ -0,0 +1,255 @@
+/*******************************************************************************
+  Title          : alloc_stats.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the AllocStats and AllocScope
+									 classes, and the replacements of the global operator new
+									 and operator delete
+  Purpose        : To find out how many heap allocations each step of building
+									 the subway system and each kind of command makes
+  Usage          : Call AllocStats::enable at the start of the program, put
+									 ALLOC_SCOPE(name) at the start of each block to account
+									 for, and call AllocStats::display at the end
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "alloc_stats.h"
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+//	True while allocations are counted
+static std::atomic<bool> counting(false);
+
+//	Bytes allocated and not yet freed since counting started
+static std::atomic<int64_t> live_bytes(0);
+
+//	The names of the registered scopes, and how many there are
+static const char* scope_names[AllocStats::kScopes] = { "other" };
+static std::atomic<unsigned int> scope_count(1);
+
+//	Protects the registration of scopes
+static std::mutex scope_lock;
+
+//	The number of threads that have been given a shard
+static std::atomic<unsigned int> thread_count(0);
+
+//	The current scope and the shard of the calling thread. Both are plain
+//	integers, so reading them never allocates
+static thread_local unsigned int current_scope = 0;
+static thread_local int current_shard = -1;
+
+//	Adds value to counter
+static inline void add(std::atomic<uint64_t>& counter, uint64_t value) {
+	counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void AllocStats::enable() {
+	counting.store(true);
+}
+
+bool AllocStats::enabled() {
+	return counting.load(std::memory_order_relaxed);
+}
+
+unsigned int AllocStats::scope(const char* name) {
+	std::lock_guard<std::mutex> guard(scope_lock);
+	unsigned int count = scope_count.load();
+	for (unsigned int i = 0; i < count; ++i) {
+		if (strcmp(scope_names[i], name) == 0) {
+			return i;
+		}
+	}
+	if (count == kScopes) {
+		return 0;
+	}
+	scope_names[count] = name;
+	scope_count.store(count + 1);
+	return count;
+}
+
+unsigned int AllocStats::current() {
+	return current_scope;
+}
+
+uint64_t AllocStats::allocations() {
+	uint64_t total = 0;
+	for (unsigned int i = 0; i < scope_count.load(); ++i) {
+		total += allocations(i);
+	}
+	return total;
+}
+
+uint64_t AllocStats::allocations(unsigned int scope) {
+	uint64_t total = 0;
+	for (unsigned int s = 0; s < kShards; ++s) {
+		total += counters(s, scope).allocations.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+void AllocStats::display(std::ostream& out) {
+	//	the rows are gathered before anything is written, since writing can
+	//	allocate
+	struct Row {
+		uint64_t entries, allocations, bytes, frees, peak;
+	};
+	Row rows[kScopes];
+	unsigned int count = scope_count.load();
+	for (unsigned int i = 0; i < count; ++i) {
+		Row row = { 0, 0, 0, 0, 0 };
+		for (unsigned int s = 0; s < kShards; ++s) {
+			Counters& c = counters(s, i);
+			row.entries += c.entries.load(std::memory_order_relaxed);
+			row.allocations += c.allocations.load(std::memory_order_relaxed);
+			row.bytes += c.bytes.load(std::memory_order_relaxed);
+			row.frees += c.frees.load(std::memory_order_relaxed);
+			row.peak = std::max(row.peak, c.peak.load(std::memory_order_relaxed));
+		}
+		rows[i] = row;
+	}
+
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+	out << std::left << std::setw(26) << "allocation scope" << std::right
+			<< std::setw(10) << "entered" << std::setw(12) << "allocs"
+			<< std::setw(14) << "bytes" << std::setw(12) << "frees"
+			<< std::setw(12) << "allocs/op" << std::setw(12) << "bytes/op"
+			<< std::setw(12) << "peak KB" << std::endl;
+	out << std::fixed << std::setprecision(1);
+	for (unsigned int i = 0; i < count; ++i) {
+		const Row& r = rows[i];
+		if (r.allocations == 0 && r.frees == 0) {
+			continue;
+		}
+		out << std::left << std::setw(26) << scope_names[i] << std::right
+				<< std::setw(10) << r.entries << std::setw(12) << r.allocations
+				<< std::setw(14) << r.bytes << std::setw(12) << r.frees;
+		if (r.entries > 0) {
+			out << std::setw(12) << (double)r.allocations / r.entries
+					<< std::setw(12) << (double)r.bytes / r.entries;
+		} else {
+			out << std::setw(12) << "-" << std::setw(12) << "-";
+		}
+		out << std::setw(12) << r.peak / 1024.0 << std::endl;
+	}
+	out.flags(flags);
+	out.precision(precision);
+}
+
+void AllocStats::allocated(void* pointer) {
+	uint64_t bytes = malloc_usable_size(pointer);
+	Counters& c = counters(shard(), current_scope);
+	add(c.allocations, 1);
+	add(c.bytes, bytes);
+	int64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) +
+								 bytes;
+	if (live > (int64_t)c.peak.load(std::memory_order_relaxed)) {
+		c.peak.store(live, std::memory_order_relaxed);
+	}
+}
+
+void AllocStats::freed(void* pointer) {
+	uint64_t bytes = malloc_usable_size(pointer);
+	add(counters(shard(), current_scope).frees, 1);
+	live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+AllocStats::Counters& AllocStats::counters(unsigned int shard,
+																					 unsigned int scope) {
+	static Counters shards[kShards][kScopes];
+	return shards[shard][scope];
+}
+
+unsigned int AllocStats::shard() {
+	if (current_shard < 0) {
+		current_shard = thread_count.fetch_add(1) % kShards;
+	}
+	return current_shard;
+}
+
+AllocScope::AllocScope(unsigned int scope, bool enter)
+    : previous_(current_scope)
+{
+	current_scope = scope;
+	if (enter && counting.load(std::memory_order_relaxed)) {
+		add(AllocStats::counters(AllocStats::shard(), scope).entries, 1);
+	}
+}
+
+AllocScope::~AllocScope() {
+	current_scope = previous_;
+}
+
+//	The replacements of the global operator new and operator delete
+
+static inline void* allocate(std::size_t size) {
+	void* pointer = malloc(size ? size : 1);
+	if (pointer && counting.load(std::memory_order_relaxed)) {
+		AllocStats::allocated(pointer);
+	}
+	return pointer;
+}
+
+static inline void deallocate(void* pointer) {
+	if (pointer && counting.load(std::memory_order_relaxed)) {
+		AllocStats::freed(pointer);
+	}
+	free(pointer);
+}
+
+void* operator new(std::size_t size) {
+	void* pointer = allocate(size);
+	if (!pointer) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+	deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+	deallocate(pointer);
+}
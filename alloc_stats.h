@@ -0,0 +1,136 @@
+/*******************************************************************************
+  Title          : alloc_stats.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the AllocStats and AllocScope classes
+  Purpose        : To find out how many heap allocations each step of building
+									 the subway system and each kind of command makes
+  Usage          : Call AllocStats::enable at the start of the program, put
+									 ALLOC_SCOPE(name) at the start of each block to account
+									 for, and call AllocStats::display at the end
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __ALLOC_STATS_H__
+#define __ALLOC_STATS_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <iostream>
+
+/*******************************************************************************
+
+		AllocStats replaces the global operator new and operator delete with
+		ones that call malloc and free and, once AllocStats::enable has been
+		called, count every allocation, the bytes it took (as malloc reports
+		them with malloc_usable_size) and every free. Each thread has a current
+		scope, and each allocation or free is counted in it: the scopes are the
+		steps of building the subway system, the kinds of commands, and "other"
+		for everything else. The highest number of bytes the whole program had
+		allocated at once while a scope was current is its peak. Until enable
+		is called, the replaced operators only add one relaxed atomic load to
+		each allocation.
+
+		An AllocScope object makes a scope current for the thread that creates
+		it until it is destroyed, and counts how many times the scope was
+		entered, so that allocations per command can be found. The ALLOC_SCOPE
+		macro creates one for a scope named by a string literal, registering the
+		scope the first time it runs. A task handed to another thread, such as
+		one submitted to a WorkPool, is run in the scope that was current where
+		it was handed over, without counting that as another entry.
+
+		The counters are split into shards by thread so that threads rarely
+		update the same cache line. There is room for kScopes scopes; a scope
+		registered after they are used up is counted as "other".
+
+*******************************************************************************/
+
+class AllocStats {
+ public:
+	//	Maximum number of scopes, including "other"
+	static const unsigned int kScopes = 64;
+
+	//	Starts counting allocations
+	static void enable();
+
+	//	Returns true if allocations are being counted
+	static bool enabled();
+
+	//	Returns the number of the scope named name, which must be a string that
+	//	is never freed, such as a literal, registering it if needed. Scope 0
+	//	is "other"
+	static unsigned int scope(const char* name);
+
+	//	Returns the number of the current scope of the calling thread
+	static unsigned int current();
+
+	//	Returns the number of allocations counted so far in every scope
+	static uint64_t allocations();
+
+	//	Returns the number of allocations counted so far in scope
+	static uint64_t allocations(unsigned int scope);
+
+	//	Displays a table with a row for each scope that has allocated: how many
+	//	times it was entered, its allocations, bytes and frees, its allocations
+	//	and bytes per entry, and its peak
+	static void display(std::ostream& out);
+
+	//	Counts the allocation of the block at pointer, or its free, in the
+	//	current scope of the calling thread. Called by operator new and
+	//	operator delete
+	static void allocated(void* pointer);
+	static void freed(void* pointer);
+
+ private:
+	friend class AllocScope;
+
+	//	Number of shards of counters
+	static const unsigned int kShards = 16;
+
+	//	The counters of one scope in one shard, padded to a cache line
+	struct Counters {
+		std::atomic<uint64_t> entries;
+		std::atomic<uint64_t> allocations;
+		std::atomic<uint64_t> bytes;
+		std::atomic<uint64_t> frees;
+		std::atomic<uint64_t> peak;
+		char padding[24];
+	};
+
+	//	Returns the counters of scope in shard
+	static Counters& counters(unsigned int shard, unsigned int scope);
+
+	//	Returns the shard of the calling thread
+	static unsigned int shard();
+};
+
+class AllocScope {
+ public:
+	//	Makes scope the current scope of the calling thread, and counts it as
+	//	an entry into scope if enter is true
+	explicit AllocScope(unsigned int scope, bool enter = true);
+
+	//	Makes the scope that was current before this object was created current
+	//	again
+	~AllocScope();
+
+ private:
+	AllocScope(const AllocScope&);
+	AllocScope& operator=(const AllocScope&);
+
+	//	The scope that was current before
+	unsigned int previous_;
+};
+
+#define ALLOC_CONCAT2(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT2(a, b)
+#define ALLOC_SCOPE(name) \
+	static const unsigned int ALLOC_CONCAT(alloc_scope_id_, __LINE__) = \
+		AllocStats::scope(name); \
+	AllocScope ALLOC_CONCAT(alloc_scope_, __LINE__)( \
+		ALLOC_CONCAT(alloc_scope_id_, __LINE__))
+
+#endif
+
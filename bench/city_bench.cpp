@@ -0,0 +1,377 @@
+/*******************************************************************************
+  Title          : city_bench.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : Times reading, building and querying subway systems of
+									 synthetic cities of several sizes
+  Purpose        : To measure how each step of building a SubwaySystem and each
+									 kind of query scales with the number of entrances, so that
+									 changes that make any of them slower are noticed
+  Usage          : bench/city_bench [options] [entrances ...], where each
+									 entrances is the size of a city to generate (1000, 3000
+									 and 10000 by default). Options are --queries N (the
+									 number of each kind of query, 10000 by default), --seed S
+									 and --max-system N (the largest city that is queried and
+									 whose entrances are also added one at a time, 20000 by
+									 default; larger cities are only generated, read and 
+									 made, since adding entrances one at a time and some
+									 indexes take time proportional to the square of their
+									 number). The report is written to standard output, with
+									 the number of heap allocations per operation of each 
+									 benchmark in its last column
+  Build with     : make bench
+  Modifications  :
+
+*******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "alloc_stats.h"
+#include "haversine.h"
+#include "subway_file.h"
+
+using namespace std;
+
+//	Train lines that share a corridor of track, like the trunk lines of New
+//	York City. Each corridor of a synthetic city is served by one of them
+static const char* kLineGroups[] = {
+	"1-2-3", "4-5-6", "A-C-E", "B-D-F-M", "N-Q-R-W", "J-Z", "L", "G", "7",
+	"2-3", "4-5", "A-C", "B-D", "N-R", "F", "E", "1", "6", "Q", "R", "M",
+	"SIR", "S", "FS", "W", "J"
+};
+
+//	Corners that entrances of a station are named after
+static const char* kCorners[] = { "NE", "NW", "SE", "SW" };
+
+//	Returns the number of seconds since start
+static double seconds_since(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//	Returns the number of allocations counted so far in the scope named name
+static uint64_t scope_allocations(const char* name) {
+	return AllocStats::allocations(AllocStats::scope(name));
+}
+
+//	A synthetic city: where its entrances are, and the box that holds them
+struct City {
+	double min_latitude;
+	double min_longitude;
+	double max_latitude;
+	double max_longitude;
+	unsigned int stations;
+};
+
+//	Writes a subway file of about entrances entrances to path, in the format
+//	of the NYC OpenData file, and returns the city it describes. Stations are
+//	laid about 0.8 km apart along corridors that wander across a square city
+//	as large as New York City is for its number of stations. Every station has
+//	one to seven entrances within 150 meters of it, all served by the lines of
+//	its corridor, so they form one station when the file is read
+static City generate_city(unsigned int entrances, unsigned int seed,
+													const string& path) {
+	const double kLatitude = 40.7, kLongitude = -73.95;
+	const double kmPerLatitude = RA * TO_RAD;
+	const double kmPerLongitude = kmPerLatitude * cos(TO_RAD * kLatitude);
+	mt19937 random(seed);
+	uniform_real_distribution<double> unit(0, 1);
+	uniform_int_distribution<unsigned int> entrance_count(1, 7);
+
+	//	New York City has about one station every 2 square kilometers
+	unsigned int stations = max(1U, entrances / 4);
+	double side = sqrt(2.0 * stations);
+	unsigned int corridor_length = 40;
+	unsigned int groups = sizeof(kLineGroups) / sizeof(kLineGroups[0]);
+
+	ofstream out(path.c_str());
+	out << fixed << setprecision(8);
+	City city = { kLatitude, kLongitude, kLatitude, kLongitude, 0 };
+	unsigned int written = 0;
+	double x = 0, y = 0, heading = 0;
+	for (unsigned int s = 0; written < entrances; ++s) {
+		if (s % corridor_length == 0) {
+			x = unit(random) * side;
+			y = unit(random) * side;
+			heading = unit(random) * 2 * M_PI;
+		} else {
+			//	turn a little, step to the next station and stay in the city
+			heading += (unit(random) - 0.5) * 0.6;
+			x += cos(heading) * (0.7 + 0.3 * unit(random));
+			y += sin(heading) * (0.7 + 0.3 * unit(random));
+			if (x < 0 || x > side || y < 0 || y > side) {
+				heading += M_PI;
+				x = min(max(x, 0.0), side);
+				y = min(max(y, 0.0), side);
+			}
+		}
+		const char* lines = kLineGroups[(s / corridor_length) % groups];
+		unsigned int count = min(entrance_count(random), entrances - written);
+		for (unsigned int k = 0; k < count; ++k) {
+			double angle = unit(random) * 2 * M_PI;
+			double distance = 0.04 + 0.11 * unit(random);
+			double latitude = kLatitude +
+				(y - side / 2 + sin(angle) * distance) / kmPerLatitude;
+			double longitude = kLongitude +
+				(x - side / 2 + cos(angle) * distance) / kmPerLongitude;
+			city.min_latitude = min(city.min_latitude, latitude);
+			city.min_longitude = min(city.min_longitude, longitude);
+			city.max_latitude = max(city.max_latitude, latitude);
+			city.max_longitude = max(city.max_longitude, longitude);
+			out << ++written << ",http://web.mta.info/nyct/service/,"
+					<< s << " St & Corridor " << s / corridor_length << " Ave at "
+					<< kCorners[k % 4];
+			if (k >= 4) {
+				out << k / 4;
+			}
+			out << ",POINT( " << longitude << " " << latitude << ")," << lines
+					<< "\n";
+		}
+		city.stations = s + 1;
+	}
+	return city;
+}
+
+//	Writes one line of the report, for a benchmark of operations operations
+//	that took seconds seconds and made allocations heap allocations
+static void report(unsigned int entrances, unsigned int stations,
+									 const char* benchmark, unsigned long operations,
+									 double seconds, uint64_t allocations) {
+	cout << entrances << "\t" << stations << "\t" << benchmark << "\t"
+			 << operations << "\t" << setprecision(6) << seconds << "\t"
+			 << setprecision(1) << (operations ? seconds * 1e9 / operations : 0)
+			 << "\t" << setprecision(2) 
+			 << (operations ? (double)allocations / operations : 0) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+	unsigned int queries = 10000;
+	unsigned int seed = 335;
+	unsigned int max_system = 20000;
+	vector<unsigned int> sizes;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--queries" && i + 1 < argc) {
+			queries = strtoul(argv[++i], NULL, 10);
+		} else if (arg == "--seed" && i + 1 < argc) {
+			seed = strtoul(argv[++i], NULL, 10);
+		} else if (arg == "--max-system" && i + 1 < argc) {
+			max_system = strtoul(argv[++i], NULL, 10);
+		} else if (strtoul(argv[i], NULL, 10) > 0) {
+			sizes.push_back(strtoul(argv[i], NULL, 10));
+		} else {
+			cerr << "Usage: " << argv[0] << " [--queries N] [--seed S] "
+					 << "[--max-system N] [entrances ...]\n";
+			exit(1);
+		}
+	}
+	if (sizes.empty()) {
+		sizes.push_back(1000);
+		sizes.push_back(3000);
+		sizes.push_back(10000);
+	}
+
+	const char* directory = getenv("TMPDIR");
+	AllocStats::enable();
+	cout << fixed;
+	cout << "entrances\tstations\tbenchmark\toperations\tseconds\tns_per_op"
+			 << "\tallocs_per_op\n";
+	for (auto& size : sizes) {
+		string path = string(directory ? directory : "/tmp") + "/city_" +
+									to_string(size) + ".csv";
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		uint64_t allocations = AllocStats::allocations();
+		City city = generate_city(size, seed, path);
+		report(size, city.stations, "generate", size, seconds_since(start),
+					 AllocStats::allocations() - allocations);
+
+		vector<Entrance> entrances;
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		if (!read_subway_file(path.c_str(), entrances)) {
+			cerr << "Unable to write " << path << endl;
+			exit(1);
+		}
+		report(size, city.stations, "csv_ingest", entrances.size(),
+					 seconds_since(start), AllocStats::allocations() - allocations);
+		vector<Entrance> parsed;
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		read_subway_file(path.c_str(), parsed, 0);
+		report(size, city.stations, "csv_ingest_parallel", parsed.size(),
+					 seconds_since(start), AllocStats::allocations() - allocations);
+		remove(path.c_str());
+		if (parsed.size() != entrances.size()) {
+			cerr << "Reading " << path << " on every thread found "
+					 << parsed.size() << " entrances instead of " << entrances.size()
+					 << endl;
+			exit(1);
+		}
+
+		//	adding the entrances one at a time compares each with every one 
+		//	before it, so it is only timed for the cities that are queried
+		if (size <= max_system) {
+			SubwaySystem one_at_a_time;
+			start = chrono::steady_clock::now();
+			allocations = AllocStats::allocations();
+			for (auto& e : entrances) {
+				one_at_a_time.add(e);
+			}
+			report(size, city.stations, "add", entrances.size(),
+						 seconds_since(start), AllocStats::allocations() - allocations);
+		}
+		SubwaySystem subway_system;
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		subway_system.add(entrances, 0);
+		report(size, city.stations, "add_parallel", entrances.size(),
+					 seconds_since(start), AllocStats::allocations() - allocations);
+		const char* steps[3] = { "make_stations", "sort_entrances", "make_lines" };
+		uint64_t step_allocations[3];
+		for (int i = 0; i < 3; ++i) {
+			step_allocations[i] = scope_allocations(steps[i]);
+		}
+		uint64_t order_allocations = scope_allocations("order_entrances") +
+																 scope_allocations("make_entrance_tree") +
+																 scope_allocations("build_entrance_tree");
+		subway_system.make_subway_system(0);
+		for (int i = 0; i < 3; ++i) {
+			step_allocations[i] = scope_allocations(steps[i]) - step_allocations[i];
+		}
+		//	the entrances are put in order and their tree built in scopes of 
+		//	their own
+		step_allocations[1] += scope_allocations("order_entrances") +
+													 scope_allocations("make_entrance_tree") +
+													 scope_allocations("build_entrance_tree") -
+													 order_allocations;
+		unsigned int stations = subway_system.stations();
+		const SubwaySystem::BuildTimes& times = subway_system.build_times();
+		report(size, stations, steps[0], stations, times.stations,
+					 step_allocations[0]);
+		report(size, stations, steps[1], size, times.entrances,
+					 step_allocations[1]);
+		report(size, stations, steps[2], DEFAULT, times.lines, 
+					 step_allocations[2]);
+		report(size, stations, "make_subway_system", 1, times.total,
+					 step_allocations[0] + step_allocations[1] + step_allocations[2]);
+		if (size > max_system) {
+			cerr << "Only generating, reading and making the city of " << size
+					 << " entrances; raise --max-system to query it" << endl;
+			continue;
+		}
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		subway_system.warm();
+		report(size, stations, "warm", 1, seconds_since(start),
+					 AllocStats::allocations() - allocations);
+
+		//	look up the names of random entrances, about one in four of which
+		//	is the name of its station, and every line by name
+		mt19937 random(seed);
+		uniform_int_distribution<unsigned int> pick(0, entrances.size() - 1);
+		QueryScratch scratch;
+		unsigned long found = 0;
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		for (unsigned int q = 0; q < queries; ++q) {
+			found += subway_system.find_entrances(
+				entrances[pick(random)].get_entrance_name(), scratch);
+		}
+		report(size, stations, "find_entrances", queries, seconds_since(start),
+					 AllocStats::allocations() - allocations);
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		for (unsigned int q = 0; q < queries; ++q) {
+			found += subway_system.find_line_stations(
+				convert_to_string(q % DEFAULT), scratch);
+		}
+		report(size, stations, "find_line_stations", queries,
+					 seconds_since(start), AllocStats::allocations() - allocations);
+
+		//	every nearest query at the same random points in the city
+		uniform_real_distribution<double> latitude(city.min_latitude,
+																							 city.max_latitude);
+		uniform_real_distribution<double> longitude(city.min_longitude,
+																								city.max_longitude);
+		vector< pair<double, double> > points(queries);
+		for (auto& p : points) {
+			p.first = latitude(random);
+			p.second = longitude(random);
+		}
+		const char* names[] = {
+			"nearest_station", "nearest_lines", "nearest_entrance", "nearest_all",
+			"closest_line", "nearest_station_on_line", "nearest_station_by_line"
+		};
+		for (int kind = 0; kind < 7; ++kind) {
+			start = chrono::steady_clock::now();
+			allocations = AllocStats::allocations();
+			for (unsigned int q = 0; q < queries; ++q) {
+				double lat = points[q].first, lon = points[q].second;
+				switch (kind) {
+					case 0: subway_system.find_nearest_stations(lat, lon, scratch);
+						break;
+					case 1: subway_system.find_nearest_lines(lat, lon, scratch);
+						break;
+					case 2: subway_system.find_nearest_entrances(lat, lon, scratch);
+						break;
+					case 3: subway_system.find_nearest_all(lat, lon, scratch);
+						break;
+					case 4: subway_system.find_closest_lines(lat, lon, scratch);
+						break;
+					case 5: subway_system.find_nearest_station_on_line(lat, lon,
+										convert_to_string(q % DEFAULT), scratch);
+						break;
+					default: subway_system.find_nearest_station_by_line(lat, lon,
+										 scratch);
+				}
+				found += scratch.stations.size() + scratch.entrances.size();
+			}
+			report(size, stations, names[kind], queries, seconds_since(start),
+						 AllocStats::allocations() - allocations);
+		}
+		//	the entrances were found where they are when they were added, so 
+		//	the first delta only checks that; after that removing random 
+		//	entrances and adding them back only remakes their stations
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		subway_system.apply_delta(vector<Entrance>(), vector<int>());
+		report(size, stations, "delta_index", size, seconds_since(start),
+					 AllocStats::allocations() - allocations);
+		vector<unsigned int> picked(entrances.size());
+		for (unsigned int i = 0; i < picked.size(); ++i) {
+			picked[i] = i;
+		}
+		shuffle(picked.begin(), picked.end(), random);
+		picked.resize(min(100U, (unsigned int)picked.size()));
+		vector<Entrance> adds;
+		vector<int> removes;
+		for (auto& i : picked) {
+			adds.push_back(entrances[i]);
+			removes.push_back(entrances[i].get_id());
+		}
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		subway_system.apply_delta(vector<Entrance>(), removes);
+		report(size, stations, "delta_remove", removes.size(), 
+					 seconds_since(start), AllocStats::allocations() - allocations);
+		start = chrono::steady_clock::now();
+		allocations = AllocStats::allocations();
+		subway_system.apply_delta(adds, vector<int>());
+		report(size, subway_system.stations(), "delta_add", adds.size(),
+					 seconds_since(start), AllocStats::allocations() - allocations);
+
+		//	keeps the queries from being optimized away
+		if (found == 0) {
+			cerr << "No query found anything" << endl;
+		}
+	}
+	return 0;
+}
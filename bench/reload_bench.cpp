@@ -0,0 +1,181 @@
+/*******************************************************************************
+  Title          : reload_bench.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : Times nearest station queries on several threads while the
+									 subway system is made again and published over and over
+  Purpose        : To measure whether reloading the subway system through a
+									 LiveSubwaySystem object ever makes a query wait, and to
+									 check that every query gets a complete version to answer
+									 from
+  Usage          : bench/reload_bench subway_entrances_cleaned.csv [reloads]
+									 [threads], where reloads is the number of times the
+									 subway system is made again (20 by default) and threads
+									 is the number of querying threads (one less than the
+									 number of hardware threads by default)
+  Build with     : make reload_bench
+  Modifications  :
+
+*******************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+#include "live_subway_system.h"
+#include "subway_file.h"
+
+using namespace std;
+
+//	Returns the number of seconds since start
+static double seconds_since(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//	A random point and the name of the nearest station to it
+struct Query {
+	double latitude;
+	double longitude;
+	string station;
+};
+
+//	Queries live on threads threads until stop is set, and writes the time
+//	each query took, in microseconds, to latencies and the number of answers
+//	that differ from the expected ones to mismatches
+static void hammer(const LiveSubwaySystem& live, const vector<Query>& queries,
+									 unsigned int threads, const atomic<bool>& stop,
+									 vector<double>& latencies, unsigned long& mismatches) {
+	vector< vector<double> > times(threads);
+	vector<unsigned long> wrong(threads, 0);
+	vector<thread> workers;
+	for (unsigned int t = 0; t < threads; ++t) {
+		workers.push_back(thread([&, t]() {
+			QueryScratch scratch;
+			for (unsigned int i = t; !stop.load(memory_order_relaxed); ++i) {
+				const Query& q = queries[i % queries.size()];
+				chrono::steady_clock::time_point start = chrono::steady_clock::now();
+				{
+					LiveSubwaySystem::Reader subway_system(live);
+					subway_system->find_nearest_stations(q.latitude, q.longitude,
+																							 scratch);
+					if (scratch.stations.empty() ||
+							scratch.stations[0]->get_station_name() != q.station) {
+						++wrong[t];
+					}
+				}
+				times[t].push_back(seconds_since(start) * 1e6);
+			}
+		}));
+	}
+	for (auto& w : workers) {
+		w.join();
+	}
+	latencies.clear();
+	mismatches = 0;
+	for (unsigned int t = 0; t < threads; ++t) {
+		latencies.insert(latencies.end(), times[t].begin(), times[t].end());
+		mismatches += wrong[t];
+	}
+	sort(latencies.begin(), latencies.end());
+}
+
+//	Writes one line of the report for a phase that took seconds seconds
+static void report(const char* phase, double seconds,
+									 const vector<double>& latencies, unsigned long mismatches) {
+	unsigned long n = latencies.size();
+	cout << setw(8) << phase << " " << n << " queries, "
+			 << setprecision(0) << n / seconds << " per second, latency us p50 "
+			 << setprecision(2) << (n ? latencies[n / 2] : 0) << " p99 "
+			 << (n ? latencies[n * 99 / 100] : 0) << " p99.9 "
+			 << (n ? latencies[n * 999 / 1000] : 0) << " max "
+			 << (n ? latencies[n - 1] : 0) << ", mismatched answers "
+			 << mismatches << "\n";
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		cerr << "Usage: " << argv[0] << " subway_file [reloads] [threads]\n";
+		exit(1);
+	}
+	const char* path = argv[1];
+	unsigned int reloads = (argc > 2) ? strtoul(argv[2], NULL, 10) : 20;
+	unsigned int threads = (argc > 3) ? strtoul(argv[3], NULL, 10)
+		: max(2U, thread::hardware_concurrency()) - 1;
+
+	auto make = [path]() -> SubwaySystem* {
+		SubwaySystem* subway_system = new SubwaySystem();
+		if (!read_subway_file(path, *subway_system)) {
+			delete subway_system;
+			return NULL;
+		}
+		subway_system->make_subway_system();
+		return subway_system;
+	};
+	LiveSubwaySystem live;
+	SubwaySystem* first = make();
+	if (!first) {
+		cerr << "Unable to open subway file: " << path << endl;
+		exit(1);
+	}
+	live.publish(first);
+
+	//	every version is made from the same file, so every version must give
+	//	the answers of the first
+	mt19937 random(335);
+	uniform_real_distribution<double> latitude(40.55, 40.90);
+	uniform_real_distribution<double> longitude(-74.05, -73.75);
+	vector<Query> queries(4096);
+	QueryScratch scratch;
+	for (auto& q : queries) {
+		q.latitude = latitude(random);
+		q.longitude = longitude(random);
+		first->find_nearest_stations(q.latitude, q.longitude, scratch);
+		q.station = scratch.stations.empty() ? ""
+																				 : scratch.stations[0]->get_station_name();
+	}
+
+	cout << fixed << "querying threads " << threads << ", reloads " << reloads
+			 << "\n";
+	vector<double> latencies;
+	unsigned long mismatches, total_mismatches = 0;
+	atomic<bool> stop(false);
+
+	//	reload over and over while the threads query, then query for as long
+	//	without reloading
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	thread reloader([&]() {
+		for (unsigned int r = 0; r < reloads; ++r) {
+			while (!live.reload(make)) {
+				this_thread::yield();
+			}
+			live.wait();
+		}
+		stop.store(true);
+	});
+	hammer(live, queries, threads, stop, latencies, mismatches);
+	reloader.join();
+	double seconds = seconds_since(start);
+	report("reload", seconds, latencies, mismatches);
+	total_mismatches += mismatches;
+
+	stop.store(false);
+	thread timer([&]() {
+		this_thread::sleep_for(chrono::duration<double>(seconds));
+		stop.store(true);
+	});
+	start = chrono::steady_clock::now();
+	hammer(live, queries, threads, stop, latencies, mismatches);
+	timer.join();
+	report("steady", seconds_since(start), latencies, mismatches);
+	total_mismatches += mismatches;
+
+	cout << "versions published " << live.versions() << ", mean reload "
+			 << setprecision(1) << seconds * 1000 / max(1U, reloads) << " ms\n";
+	return total_mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+  Title          : route_bench.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : Times the three ways of finding the fastest route between
+									 two subway stations: Dijkstra's algorithm, A* and the
+									 contraction hierarchy
+  Purpose        : To measure how much faster the contraction hierarchy answers
+									 route queries, and to check that all three find the same
+									 travel times
+  Usage          : bench/route_bench subway_entrances_cleaned.csv [queries]
+									 [seed], where queries is the number of random station
+									 pairs to route between (10000 by default)
+  Build with     : make route_bench
+  Modifications  :
+
+*******************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <stdlib.h>
+#include <math.h>
+#include "subway_file.h"
+
+using namespace std;
+
+//	Returns the number of seconds since start
+static double seconds_since(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		cerr << "Usage: " << argv[0] << " subway_file [queries] [seed]\n";
+		exit(1);
+	}
+	unsigned int queries = (argc > 2) ? strtoul(argv[2], NULL, 10) : 10000;
+	unsigned int seed = (argc > 3) ? strtoul(argv[3], NULL, 10) : 335;
+
+	SubwaySystem subway_system;
+	if (!read_subway_file(argv[1], subway_system)) {
+		cerr << "Unable to open subway file: " << argv[1] << endl;
+		exit(1);
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	subway_system.make_subway_system();
+	double build_time = seconds_since(start);
+	start = chrono::steady_clock::now();
+	subway_system.enable_hierarchy();
+	double hierarchy_time = seconds_since(start);
+
+	const RouteGraph& graph = subway_system.route_graph();
+	const ContractionHierarchy& hierarchy = subway_system.hierarchy();
+	mt19937 random(seed);
+	uniform_int_distribution<unsigned int> pick(0, graph.nodes() - 1);
+	vector< pair<unsigned int, unsigned int> > pairs(queries);
+	for (auto& p : pairs) {
+		p.first = pick(random);
+		p.second = pick(random);
+	}
+
+	QueryScratch scratch;
+	const char* names[3] = { "dijkstra", "astar", "hierarchy" };
+	vector<double> times[3];
+	double elapsed[3];
+	for (int method = 0; method < 3; ++method) {
+		times[method].reserve(queries);
+		start = chrono::steady_clock::now();
+		for (auto& p : pairs) {
+			bool found = (method == 2)
+				? hierarchy.shortest_path(p.first, p.second, scratch)
+				: graph.shortest_path(p.first, p.second, scratch, method == 1);
+			times[method].push_back(found ? scratch.distance : HUGE_VAL);
+		}
+		elapsed[method] = seconds_since(start);
+	}
+
+	unsigned int mismatches = 0;
+	for (unsigned int i = 0; i < queries; ++i) {
+		for (int method = 1; method < 3; ++method) {
+			//	unreachable pairs have infinite times, which must match exactly
+			if (times[method][i] != times[0][i] &&
+					!(fabs(times[method][i] - times[0][i]) <= 1e-9)) {
+				++mismatches;
+			}
+		}
+	}
+
+	cout << "stations " << graph.nodes() << ", edges " << graph.edges()
+			 << ", shortcuts " << hierarchy.shortcuts() << "\n";
+	cout << fixed << setprecision(3);
+	cout << "build " << build_time * 1000 << " ms, hierarchy "
+			 << hierarchy_time * 1000 << " ms\n";
+	for (int method = 0; method < 3; ++method) {
+		cout << setw(10) << names[method] << " " << queries << " queries "
+				 << elapsed[method] * 1000 << " ms, "
+				 << elapsed[method] * 1e6 / queries << " us/query, speedup "
+				 << setprecision(2) << elapsed[0] / elapsed[method]
+				 << setprecision(3) << "\n";
+	}
+	cout << "mismatched travel times " << mismatches << "\n";
+	return mismatches == 0 ? 0 : 1;
+}
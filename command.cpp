@@ -0,0 +1,438 @@
+/*******************************************************************************
+  Title          : command.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the Command class and the
+									 parse_command function
+  Purpose        : To parse the lines of a command file into commands and
+									 their arguments
+  Usage          : Call get_next on a Command object to parse the next line of
+									 an input stream, or use the CommandFile class to parse a
+									 whole command file
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "command.h"
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+
+//	The command words in the order of Command_type, followed by the names of 
+//	bad_cmmd and null_cmmd
+static const char* const kCommandNames[] = {
+	"list_line_stations", "list_all_stations", "list_entrances",
+	"nearest_station", "nearest_lines", "nearest_entrance", "nearest_all",
+	"route", "transfers", "walk_route", "closest_line",
+	"nearest_station_on_line", "nearest_station_by_line", "stations_in_box",
+	"entrances_in_box", "stations_in_polygon", "entrances_in_polygon", "bad",
+	"null"
+};
+
+//	Returns true if c is a whitespace character
+static inline bool is_space(char c) {
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+//	Returns true if c is a decimal digit
+static inline bool is_digit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+//	Reads a number that starts at or after the whitespace at position pos of
+//	text, stopping at last, into value and moves pos past it. Accepts the same
+//	numbers as reading a double from an input stream: an optional sign, digits
+//	with an optional decimal point and an optional exponent. Returns false if
+//	there is no such number or it is too large for a double
+static bool read_number(const char* text, unsigned long& pos,
+												unsigned long last, double& value) {
+	//	powers of ten that are exactly representable as doubles
+	static const double kPowers[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+		1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	while (pos < last && is_space(text[pos])) {
+		++pos;
+	}
+	unsigned long start = pos;
+	bool negative = false;
+	if (pos < last && (text[pos] == '+' || text[pos] == '-')) {
+		negative = text[pos] == '-';
+		++pos;
+	}
+
+	//	the significant digits are collected in mantissa as long as they fit
+	//	exactly in a double, so that most numbers need no call to strtod
+	unsigned long long mantissa = 0;
+	int significant = 0;
+	int exponent = 0;
+	bool digits = false;
+	while (pos < last && is_digit(text[pos])) {
+		if (mantissa != 0 || text[pos] != '0') {
+			mantissa = mantissa * 10 + (text[pos] - '0');
+			++significant;
+		}
+		++pos;
+		digits = true;
+	}
+	if (pos < last && text[pos] == '.') {
+		++pos;
+		while (pos < last && is_digit(text[pos])) {
+			if (mantissa != 0 || text[pos] != '0') {
+				mantissa = mantissa * 10 + (text[pos] - '0');
+				++significant;
+			}
+			--exponent;
+			++pos;
+			digits = true;
+		}
+	}
+	if (digits && pos < last && (text[pos] == 'e' || text[pos] == 'E')) {
+		++pos;
+		bool negative_exponent = false;
+		if (pos < last && (text[pos] == '+' || text[pos] == '-')) {
+			negative_exponent = text[pos] == '-';
+			++pos;
+		}
+		int written = 0;
+		unsigned long exponent_start = pos;
+		while (pos < last && is_digit(text[pos])) {
+			if (pos - exponent_start < 4) {
+				written = written * 10 + (text[pos] - '0');
+			} else {
+				//	too long to take the short way below
+				significant = 100;
+			}
+			++pos;
+		}
+		if (pos == exponent_start) {
+			//	an exponent without digits
+			digits = false;
+		}
+		exponent += negative_exponent ? -written : written;
+	}
+	if (!digits) {
+		value = 0;
+		return false;
+	}
+
+	//	a mantissa of at most 15 digits and a power of ten of at most 22 are
+	//	both exact, so a single multiplication or division gives the same
+	//	correctly rounded result as strtod
+	if (significant <= 15 && exponent >= -22 && exponent <= 22) {
+		value = (exponent < 0) ? mantissa / kPowers[-exponent]
+													 : mantissa * kPowers[exponent];
+		if (negative) {
+			value = -value;
+		}
+		return true;
+	}
+
+	//	strtod needs a terminated string; the number is never longer than a line
+	char number[kLongestLine + 1];
+	unsigned long length = pos - start;
+	memcpy(number, text + start, length);
+	number[length] = '\0';
+	char* end;
+	value = strtod(number, &end);
+	if (end != number + length || std::isinf(value)) {
+		value = 0;
+		return false;
+	}
+	return true;
+}
+
+//	Writes the error message for the line [first, last) of text to cerr
+static void line_error(const char* text, unsigned long first,
+											 unsigned long last, const char* message) {
+	std::cerr.write(text + first, last - first);
+	std::cerr << ": \t " << message << ".";
+}
+
+//	Parses the line identifier or station name that follows the command word
+//	ending at position pos of text into record. Like the rest of the line, it
+//	keeps everything after the spaces that follow the command word
+static bool read_name(const char* text, unsigned long pos, unsigned long last,
+											CommandRecord& record) {
+	while (pos < last && text[pos] == ' ') {
+		++pos;
+	}
+	if (pos == last) {
+		return false;
+	}
+	record.offset = pos;
+	record.length = last - pos;
+	return true;
+}
+
+//	Returns true if the characters of text in [first, last), which start with
+//	a word, contain a second word
+static bool has_two_words(const char* text, unsigned long first,
+													unsigned long last) {
+	while (first < last && !is_space(text[first])) {
+		++first;
+	}
+	while (first < last && is_space(text[first])) {
+		++first;
+	}
+	return first < last;
+}
+
+//	Returns true if anything but whitespace follows position pos of text, 
+//	stopping at last
+static bool has_more(const char* text, unsigned long pos, unsigned long last) {
+	while (pos < last && is_space(text[pos])) {
+		++pos;
+	}
+	return pos < last;
+}
+
+//	Parses the longitude and latitude that start at or after position pos of
+//	text into longitude and latitude, and moves pos past them
+static bool read_point(const char* text, unsigned long first,
+											 unsigned long& pos, unsigned long last, 
+											 const char* name, double& longitude, double& latitude) {
+	std::string message;
+	if (!read_number(text, pos, last, longitude)) {
+		message = std::string("Failed to get longitude argument for ") + name +
+							" command";
+		line_error(text, first, last, message.c_str());
+		return false;
+	}
+	if (longitude < -180 || longitude > 180) {
+		std::cerr << "\t Longitude must be in range [-180,180].";
+		return false;
+	}
+	if (!read_number(text, pos, last, latitude)) {
+		message = std::string("Failed to get latitude argument for ") + name +
+							" command";
+		line_error(text, first, last, message.c_str());
+		return false;
+	}
+	if (latitude <= -90 || latitude >= 90) {
+		std::cerr << "\t Latitude must be in range (-90,90).";
+		return false;
+	}
+	return true;
+}
+
+bool parse_command(const char* text, unsigned long first, unsigned long last,
+									 CommandRecord& record) {
+	record.type = null_cmmd;
+	record.offset = 0;
+	record.length = 0;
+	record.longitude = 0;
+	record.latitude = 0;
+	record.to_longitude = 0;
+	record.to_latitude = 0;
+
+	unsigned long pos = first;
+	while (pos < last && is_space(text[pos])) {
+		++pos;
+	}
+	if (pos == last) {
+		line_error(text, first, last, "Error in command file syntax");
+		return false;
+	}
+	unsigned long word = pos;
+	while (pos < last && !is_space(text[pos])) {
+		++pos;
+	}
+	const char* start = text + word;
+	unsigned long length = pos - word;
+
+	//	the lengths of the command words in the order of Command_type
+	static const unsigned long lengths[] = {
+		18, 17, 14, 15, 13, 16, 11, 5, 9, 10, 12, 23, 23, 15, 16, 19, 20
+	};
+	record.type = bad_cmmd;
+	for (unsigned int i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+		if (length == lengths[i] && memcmp(start, kCommandNames[i], length) == 0) {
+			record.type = (Command_type)i;
+			break;
+		}
+	}
+
+	switch (record.type) {
+		case list_line_stations_cmmd:
+			if (!read_name(text, pos, last, record)) {
+				line_error(text, first, last,
+									 "Missing line identifier for list_line_stations command");
+				return false;
+			}
+			return true;
+		case list_entrances_cmmd:
+			if (!read_name(text, pos, last, record)) {
+				line_error(text, first, last,
+									 "Missing station name for list_entrances command");
+				return false;
+			}
+			return true;
+		case nearest_station_cmmd:
+		case nearest_lines_cmmd:
+		case nearest_entrance_cmmd:
+		case nearest_all_cmmd:
+		case closest_line_cmmd:
+		case nearest_station_by_line_cmmd:
+			return read_point(text, first, pos, last, kCommandNames[record.type],
+												record.longitude, record.latitude);
+		case route_cmmd:
+			if (!read_name(text, pos, last, record) ||
+					!memchr(text + record.offset, ',', record.length)) {
+				line_error(text, first, last,
+									 "Missing station names for route command");
+				return false;
+			}
+			return true;
+		case transfers_cmmd:
+			if (!read_name(text, pos, last, record) ||
+					!has_two_words(text, record.offset, record.offset + record.length)) {
+				line_error(text, first, last,
+									 "Missing line identifiers for transfers command");
+				return false;
+			}
+			return true;
+		case nearest_station_on_line_cmmd:
+			if (!read_point(text, first, pos, last, kCommandNames[record.type],
+											record.longitude, record.latitude)) {
+				return false;
+			}
+			if (!read_name(text, pos, last, record)) {
+				line_error(text, first, last, "Missing line identifier for "
+									 "nearest_station_on_line command");
+				return false;
+			}
+			return true;
+		case stations_in_polygon_cmmd:
+		case entrances_in_polygon_cmmd: {
+			unsigned int vertices = 0;
+			read_name(text, pos, last, record);
+			while (has_more(text, pos, last)) {
+				double longitude, latitude;
+				if (!read_point(text, first, pos, last, kCommandNames[record.type],
+												longitude, latitude)) {
+					return false;
+				}
+				++vertices;
+			}
+			if (vertices < 3) {
+				std::string message = std::string("Missing polygon vertices for ") +
+															kCommandNames[record.type] + " command";
+				line_error(text, first, last, message.c_str());
+				return false;
+			}
+			return true;
+		}
+		case walk_route_cmmd:
+		case stations_in_box_cmmd:
+		case entrances_in_box_cmmd:
+			return read_point(text, first, pos, last, kCommandNames[record.type],
+												record.longitude, record.latitude) &&
+						 read_point(text, first, pos, last, kCommandNames[record.type],
+												record.to_longitude, record.to_latitude);
+		default:
+			return true;
+	}
+}
+
+const char* command_name(Command_type type) {
+	return (type < num_Command_types) ? kCommandNames[type] : "";
+}
+
+Command::Command() : type(null_cmmd), line_id(), station_name(), longitude(0),
+    latitude(0), to_longitude(0), to_latitude(0), distance(0)
+{
+}
+
+bool Command::get_next(std::istream& in) {
+	if (in.eof()) {
+		type = null_cmmd;
+		return true;
+	}
+	if (!in.good()) {
+		return false;
+	}
+	char line[kLongestLine + 1];
+	in.getline(line, sizeof(line));
+	if (in.eof()) {
+		//	a last line without a newline is not a command
+		return false;
+	}
+
+	CommandRecord record;
+	bool parsed = parse_command(line, 0, strlen(line), record);
+	if (!parsed && (record.type < nearest_station_cmmd ||
+									record.type > nearest_all_cmmd)) {
+		//	only a nearest command with invalid arguments changes the object
+		return false;
+	}
+	type = record.type;
+	if (type == list_line_stations_cmmd || type == transfers_cmmd ||
+			type == nearest_station_on_line_cmmd || 
+			type == stations_in_polygon_cmmd || type == entrances_in_polygon_cmmd) {
+		line_id.assign(line + record.offset, record.length);
+	} else if (type == list_entrances_cmmd || type == route_cmmd) {
+		station_name.assign(line + record.offset, record.length);
+	}
+	longitude = record.longitude;
+	latitude = record.latitude;
+	to_longitude = record.to_longitude;
+	to_latitude = record.to_latitude;
+	return parsed;
+}
+
+Command_type Command::type_of() const {
+	return type;
+}
+
+void Command::get_args(std::string& arg_line_identifier,
+											 std::string& arg_station_name, double& arg_longitude,
+											 double& arg_latitude, bool& result) const {
+	switch (type) {
+		case list_line_stations_cmmd:
+		case transfers_cmmd:
+			arg_line_identifier = line_id;
+			result = true;
+			break;
+		case stations_in_polygon_cmmd:
+		case entrances_in_polygon_cmmd:
+			arg_line_identifier = line_id;
+			result = true;
+			break;
+		case nearest_station_on_line_cmmd:
+			arg_line_identifier = line_id;
+			arg_longitude = longitude;
+			arg_latitude = latitude;
+			result = true;
+			break;
+		case list_entrances_cmmd:
+		case route_cmmd:
+			arg_station_name = station_name;
+			result = true;
+			break;
+		case nearest_station_cmmd:
+		case nearest_lines_cmmd:
+		case nearest_entrance_cmmd:
+		case nearest_all_cmmd:
+		case walk_route_cmmd:
+		case closest_line_cmmd:
+		case nearest_station_by_line_cmmd:
+		case stations_in_box_cmmd:
+		case entrances_in_box_cmmd:
+			arg_longitude = longitude;
+			arg_latitude = latitude;
+			result = true;
+			break;
+		default:
+			result = false;
+			break;
+	}
+}
+
+void Command::get_destination(double& arg_longitude, 
+															double& arg_latitude) const {
+	arg_longitude = to_longitude;
+	arg_latitude = to_latitude;
+}
@@ -4,7 +4,16 @@
   Created on     : April 12, 2018
   Description    : Interface for the command class
   Purpose        : The Command class represents a command object
-  Modifications  : 
+  Modifications  : October 19, 2026 - Added the nearest_all command and the
+                   CommandRecord struct, and removed the using directive
+                   October 19, 2026 - Added the route command
+                   October 19, 2026 - Added the transfers command
+                   October 19, 2026 - Added the walk_route command
+                   October 19, 2026 - Added the closest_line command
+                   October 19, 2026 - Added the nearest_station_on_line and
+                   nearest_station_by_line commands
+                   October 19, 2026 - Added the box and polygon commands
+                   October 19, 2026 - Added command_name
 
   Notes:
   This header file provides the interface to the Command class, as well as to
@@ -13,22 +22,24 @@
     Command_type
 
   All of the member functions required to utilize this class are here. 
-  There is no need to modify this class and it should not be modified!
+  The class is implemented in command.cpp.
 
-  The accompanying test driver, commandtester.cpp, show how you can use this 
-  class.  In essence, you create a Command object and then repeatedly call
+  In essence, you create a Command object and then repeatedly call
   the get_next() method passing the input stream containing the commands.
   Use type_of() and get_args() to get the command type and its associated
   argument list.
 
+  A whole command file can instead be parsed at once into a vector of
+  CommandRecord structs with the CommandFile class in command_file.h. Both
+  use parse_command(), so they accept exactly the same commands.
+
  
 ******************************************************************************/
 #ifndef __COMMAND_H__
 #define __COMMAND_H__
 
 #include <iostream>
-
-using namespace std;
+#include <string>
 
 /*******************************************************************************   
                                  Exported Types
@@ -49,12 +60,81 @@ typedef enum
     nearest_station_cmmd,
     nearest_lines_cmmd,
     nearest_entrance_cmmd,
+    nearest_all_cmmd,
+    route_cmmd,
+    transfers_cmmd,
+    walk_route_cmmd,
+    closest_line_cmmd,
+    nearest_station_on_line_cmmd,
+    nearest_station_by_line_cmmd,
+    stations_in_box_cmmd,
+    entrances_in_box_cmmd,
+    stations_in_polygon_cmmd,
+    entrances_in_polygon_cmmd,
     bad_cmmd,
     null_cmmd,
     num_Command_types
 } Command_type;
 
 
+/** kLongestLine:
+    The largest number of characters of a line of a command file that are
+    read, not counting the newline. The rest of a longer line is not read.
+*/
+const unsigned int kLongestLine = 4095;
+
+
+/** CommandRecord:
+    A parsed command, stored without any strings so that a whole command file
+    can be kept in one compact vector. For list_line_stations_cmmd and
+    list_entrances_cmmd, the line identifier or station name is the length
+    characters at position offset of the text the command was parsed from.
+    For route_cmmd, they are the two station names, separated by a comma.
+    For transfers_cmmd, they are the two line identifiers, separated by
+    whitespace.
+    For the nearest commands and closest_line_cmmd, longitude and latitude
+    are the arguments. For nearest_station_on_line_cmmd, they are followed by
+    the line identifier at offset.
+    For walk_route_cmmd, longitude and latitude are the point to start from,
+    and to_longitude and to_latitude are the point to go to. For the box
+    commands, they are two opposite corners of the box. For the polygon 
+    commands, the longitude and latitude of each vertex, separated by
+    whitespace, are at offset.
+*/
+struct CommandRecord
+{
+    Command_type  type;
+    unsigned int  offset;
+    unsigned int  length;
+    double        longitude;
+    double        latitude;
+    double        to_longitude;
+    double        to_latitude;
+};
+
+/** parse_command(text, first, last, record) parses the command on the line
+ * made of the characters of text in [first, last), which must not include
+ * the newline, into record.
+ * @pre   last - first is at most kLongestLine
+ * @post  If the line is a command, record is set to it. A line whose first
+ *        word is not a command is a bad_cmmd. If the line is blank or the
+ *        arguments of the command are missing or out of range, an error
+ *        message is written to cerr.
+ * @return true if record was set, and false if an error message was written
+ */
+bool parse_command (
+                const char    * text,
+                unsigned long   first,
+                unsigned long   last,
+                CommandRecord & record
+                );
+
+/** command_name(type) returns the word that starts a command of the given
+ * type, such as "nearest_station" for nearest_station_cmmd, or "bad" and
+ * "null" for bad_cmmd and null_cmmd.
+ */
+const char * command_name ( Command_type type );
+
 
 /*******************************************************************************   
                               Command Class Interface
@@ -82,7 +162,7 @@ public:
      * @return true if the command was initialized to something other than a
      *        bad_command, and false otherwise.
      */
-    bool get_next (istream & in );
+    bool get_next (std::istream & in );
 
     /** typeof() returns the type of the Command on which it is called.
      * @pre  None
@@ -105,24 +185,53 @@ public:
      * if nearest_station_cmmd, then longitude and latitude
      * if nearest_lines_cmmd, then longitude and latitude
      * if nearest_entrance_cmmd, then longitude and latitude
+     * if nearest_all_cmmd, then longitude and latitude
+     * if route_cmmd, then station_name, which is the names of the two
+     *   stations separated by a comma
+     * if transfers_cmmd, then line_identifier, which is the two line
+     *   identifiers separated by whitespace
+     * if closest_line_cmmd, then longitude and latitude
+     * if nearest_station_on_line_cmmd, then longitude, latitude and 
+     *   line_identifier
+     * if nearest_station_by_line_cmmd, then longitude and latitude
+     * if walk_route_cmmd, then longitude and latitude, which are the point
+     *   to start from; get_destination() returns the point to go to
+     * if stations_in_box_cmmd or entrances_in_box_cmmd, then longitude and
+     *   latitude, which are one corner of the box; get_destination() returns
+     *   the opposite corner
+     * if stations_in_polygon_cmmd or entrances_in_polygon_cmmd, then 
+     *   line_identifier, which is the longitudes and latitudes of the 
+     *   vertices of the polygon
      * @pre  Command_type is initialized to a valid value
      * @post Either result == false or all members are
      *       set to the values in the object.
      */ 
     void  get_args (
-                string       & arg_line_identifier,
-                string       & arg_station_name,
+                std::string  & arg_line_identifier,
+                std::string  & arg_station_name,
                 double       & arg_longitude, 
                 double       & arg_latitude, 
                 bool         & result
                 ) const;
 
+    /** get_destination() sets its parameters to the point that a walk_route
+     * command goes to, or the second corner of a box command.
+     * @pre  Command_type is walk_route_cmmd or a box command
+     * @post None, as this is a const method
+     */
+    void  get_destination (
+                double       & arg_longitude,
+                double       & arg_latitude
+                ) const;
+
 private:
     Command_type type;       // The type of the Command object
-    string       line_id;
-    string       station_name;
+    std::string  line_id;
+    std::string  station_name;
     double       longitude;
     double       latitude;
+    double       to_longitude;
+    double       to_latitude;
     double       distance;
 };
 
@@ -0,0 +1,104 @@
+/*******************************************************************************
+  Title          : command_file.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the CommandFile class
+  Purpose        : To parse a whole command file at once into a compact list
+									 of commands
+  Usage          : Open a command file with a CommandFile object, call parse
+									 to get its commands and use argument to get the line
+									 identifier or station name of a command
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "command_file.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+CommandFile::CommandFile() : text_(NULL), size_(0), mapped_(false), buffer_()
+{
+}
+
+CommandFile::~CommandFile() {
+	close();
+}
+
+bool CommandFile::open(const char* path) {
+	close();
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+		void* text = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (text != MAP_FAILED) {
+			madvise(text, info.st_size, MADV_SEQUENTIAL);
+			text_ = (const char*)text;
+			size_ = info.st_size;
+			mapped_ = true;
+			::close(fd);
+			return true;
+		}
+	}
+
+	//	pipes and empty files cannot be mapped, so they are read instead
+	char block[65536];
+	ssize_t count;
+	while ((count = read(fd, block, sizeof(block))) > 0) {
+		buffer_.insert(buffer_.end(), block, block + count);
+	}
+	::close(fd);
+	if (count < 0) {
+		buffer_.clear();
+		return false;
+	}
+	text_ = buffer_.data();
+	size_ = buffer_.size();
+	return true;
+}
+
+bool CommandFile::parse(std::vector<CommandRecord>& commands) const {
+	CommandRecord command;
+	unsigned long pos = 0;
+	while (pos < size_) {
+		const char* newline = (const char*)memchr(text_ + pos, '\n', size_ - pos);
+		if (!newline) {
+			//	a last line without a newline is not a command
+			return true;
+		}
+
+		//	only the part of the line that Command::get_next would read is parsed
+		unsigned long end = newline - text_;
+		unsigned long last = (end - pos > kLongestLine) ? pos + kLongestLine : end;
+		const char* nul = (const char*)memchr(text_ + pos, '\0', last - pos);
+		if (nul) {
+			last = nul - text_;
+		}
+		if (!parse_command(text_, pos, last, command)) {
+			return false;
+		}
+		commands.push_back(command);
+		pos = end + 1;
+	}
+	return true;
+}
+
+std::string CommandFile::argument(const CommandRecord& command) const {
+	return std::string(text_ + command.offset, command.length);
+}
+
+void CommandFile::close() {
+	if (mapped_) {
+		munmap((void*)text_, size_);
+	}
+	text_ = NULL;
+	size_ = 0;
+	mapped_ = false;
+	buffer_.clear();
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+  Title          : command_file.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the CommandFile class
+  Purpose        : To parse a whole command file at once into a compact list
+									 of commands
+  Usage          : Open a command file with a CommandFile object, call parse
+									 to get its commands and use argument to get the line
+									 identifier or station name of a command
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __COMMAND_FILE_H__
+#define __COMMAND_FILE_H__
+
+#include <string>
+#include <vector>
+#include "command.h"
+
+/*******************************************************************************
+
+		The CommandFile class gives access to the text of a command file and
+		parses it. The file is mapped into memory instead of being read, so
+		opening it costs the same no matter how large it is. If the file cannot be
+		mapped, such as when it is a pipe, it is read into memory instead.
+
+		parse reads the commands line by line with parse_command, so it accepts
+		exactly the commands that Command::get_next does. It stops at the first
+		line that is not a valid command, and, like Command::get_next, it ignores
+		a last line that has no newline and everything after the first 4095
+		characters of a line. No strings are created while parsing: the
+		line identifier or station name of a command is only located in the text
+		of the file, and argument copies it out when the command is executed. The
+		CommandRecord structs therefore refer to the CommandFile object, which
+		must exist for as long as they are used.
+
+*******************************************************************************/
+
+class CommandFile {
+ public:
+	//	Creates a CommandFile object that has no file open
+	CommandFile();
+
+	//	Unmaps the file, if any, and destroys CommandFile object
+	~CommandFile();
+
+	//	Opens the command file at path. Returns false if it cannot be opened
+	bool open(const char* path);
+
+	//	Parses every command in the file, in order, and appends them to
+	//	commands. Returns true if the end of the file was reached, and false if
+	//	parsing stopped at a line that could not be parsed, after writing an
+	//	error message about it to cerr, like Command::get_next
+	bool parse(std::vector<CommandRecord>& commands) const;
+
+	//	Returns the line identifier or station name of command
+	std::string argument(const CommandRecord& command) const;
+
+	//	Unmaps the file, if any
+	void close();
+
+ private:
+	CommandFile(const CommandFile&);
+	CommandFile& operator=(const CommandFile&);
+
+	//	The contents of the file
+	const char* text_;
+
+	//	The number of characters in the file
+	unsigned long size_;
+
+	//	True if text_ is mapped, and false if it points into buffer_
+	bool mapped_;
+
+	//	The contents of a file that could not be mapped
+	std::vector<char> buffer_;
+};
+
+#endif
+
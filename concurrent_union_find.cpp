@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Title          : concurrent_union_find.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the ConcurrentUnionFind class
+  Purpose        : To join numbered elements into disjoint sets from several
+									 threads at once without locks
+  Usage          : Create a ConcurrentUnionFind object with the number of
+									 elements, call unite from any number of threads and call
+									 find to get the root of an element's set
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "concurrent_union_find.h"
+#include <utility>
+
+ConcurrentUnionFind::ConcurrentUnionFind(unsigned int size) : size_(size),
+    parents_(new std::atomic<unsigned int>[size])
+{
+	for (unsigned int i = 0; i < size; ++i) {
+		parents_[i].store(i, std::memory_order_relaxed);
+	}
+}
+
+ConcurrentUnionFind::~ConcurrentUnionFind()
+{
+}
+
+bool ConcurrentUnionFind::unite(unsigned int a, unsigned int b) {
+	while (true) {
+		a = find(a);
+		b = find(b);
+		if (a == b) {
+			return false;
+		}
+		if (a > b) {
+			std::swap(a, b);
+		}
+		//	b may have stopped being a root since find returned it, in which case
+		//	the link fails and both roots are found again
+		unsigned int expected = b;
+		if (parents_[b].compare_exchange_strong(expected, a)) {
+			return true;
+		}
+	}
+}
+
+unsigned int ConcurrentUnionFind::find(unsigned int x) {
+	unsigned int parent = parents_[x].load();
+	while (parent != x) {
+		unsigned int grandparent = parents_[parent].load();
+		//	a failed swap means another thread moved x's parent closer to the
+		//	root already, so it is simply not retried
+		if (parent != grandparent) {
+			parents_[x].compare_exchange_weak(parent, grandparent);
+		}
+		x = grandparent;
+		parent = parents_[x].load();
+	}
+	return x;
+}
+
+unsigned int ConcurrentUnionFind::size() const {
+	return size_;
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+  Title          : concurrent_union_find.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the ConcurrentUnionFind class
+  Purpose        : To join numbered elements into disjoint sets from several
+									 threads at once without locks
+  Usage          : Create a ConcurrentUnionFind object with the number of
+									 elements, call unite from any number of threads and call
+									 find to get the root of an element's set
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __CONCURRENT_UNION_FIND_H__
+#define __CONCURRENT_UNION_FIND_H__
+
+#include <atomic>
+#include <memory>
+
+/*******************************************************************************
+
+		The ConcurrentUnionFind class is a disjoint-set forest whose parent
+		links are atomic, so that unite and find can be called from any number
+		of threads at once without locks. unite links one root to another with a
+		compare-and-swap, which fails and is retried if another thread linked
+		the root first. find halves the path it follows by pointing every other
+		element on it at its grandparent, also with a compare-and-swap, so paths
+		stay short without a second pass.
+
+		A root is always linked under a smaller root, so every parent is smaller
+		than its child and the root of a set is its smallest element. The sets
+		and their roots are therefore the same whatever order the unions are
+		done in and however the threads interleave. SubwaySystem uses a
+		ConcurrentUnionFind to join entrances into stations, where the root must
+		be the entrance that comes first in the subway file.
+
+*******************************************************************************/
+
+class ConcurrentUnionFind {
+ public:
+	//	Creates a ConcurrentUnionFind object of size elements, numbered from 0,
+	//	each in a set of its own
+	explicit ConcurrentUnionFind(unsigned int size);
+
+	//	Destroys ConcurrentUnionFind object
+	~ConcurrentUnionFind();
+
+	//	Joins the sets of a and b. Returns false if they were already the same
+	bool unite(unsigned int a, unsigned int b);
+
+	//	Returns the root of x's set, which is its smallest element
+	unsigned int find(unsigned int x);
+
+	//	Returns the number of elements
+	unsigned int size() const;
+
+ private:
+	ConcurrentUnionFind(const ConcurrentUnionFind&);
+	ConcurrentUnionFind& operator=(const ConcurrentUnionFind&);
+
+	//	Number of elements
+	unsigned int size_;
+
+	//	The parent of each element, which is the element itself for a root
+	std::unique_ptr< std::atomic<unsigned int>[] > parents_;
+};
+
+#endif
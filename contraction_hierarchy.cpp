@@ -0,0 +1,509 @@
+/*******************************************************************************
+  Title          : contraction_hierarchy.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the ContractionHierarchy class
+  Purpose        : To find the fastest route between two subway stations in
+									 less time than searching the whole RouteGraph
+  Usage          : Build a ContractionHierarchy object from a RouteGraph
+									 object and call shortest_path with the nodes of two
+									 stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "contraction_hierarchy.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <math.h>
+
+ContractionHierarchy::ContractionHierarchy() : graph_(NULL), ranks_(),
+    offsets_(1, 0), arcs_(), order_(), priorities_(), added_offsets_(1, 0),
+    added_(), reached_offsets_(1, 0), reached_(), shortcuts_(0)
+{
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+{
+}
+
+void ContractionHierarchy::build(const RouteGraph& graph) {
+	typedef std::pair<double, unsigned int> Entry;
+	std::greater<Entry> later;
+	unsigned int n = graph.nodes();
+	graph_ = &graph;
+	ranks_.assign(n, 0);
+	order_.clear();
+	priorities_.clear();
+	added_offsets_.assign(1, 0);
+	added_.clear();
+	reached_offsets_.assign(1, 0);
+	reached_.clear();
+	Contraction c;
+	start(c);
+
+	std::vector<Entry> order;
+	for (unsigned int v = 0; v < n; ++v) {
+		order.push_back(Entry(priority(c, v), v));
+	}
+	std::make_heap(order.begin(), order.end(), later);
+
+	while (!order.empty()) {
+		std::pop_heap(order.begin(), order.end(), later);
+		unsigned int v = order.back().second;
+		order.pop_back();
+
+		//	priorities change as neighbors are contracted, so they are only
+		//	brought up to date when they reach the top
+		double current = priority(c, v);
+		if (!order.empty() && current > order.front().first) {
+			order.push_back(Entry(current, v));
+			std::push_heap(order.begin(), order.end(), later);
+			continue;
+		}
+
+		ranks_[v] = order_.size();
+		order_.push_back(v);
+		priorities_.push_back(current);
+		contract(c, v, &added_, &reached_);
+		added_offsets_.push_back(added_.size());
+		reached_offsets_.push_back(reached_.size());
+		remove(c, v);
+	}
+	finish(c);
+}
+
+void ContractionHierarchy::update(const std::vector<unsigned int>& changed,
+																	const std::vector<unsigned int>& touched) {
+	typedef std::pair<double, unsigned int> Entry;
+	std::greater<Entry> later;
+	unsigned int old_n = ranks_.size();
+	unsigned int n = graph_->nodes();
+
+	//	the changed nodes, the nodes that gained or lost edges in the graph, 
+	//	and the ends of the shortcuts and the upward edges of the old 
+	//	stations of the changed nodes are marked, since they lose those 
+	//	stations at another time, if at all
+	std::vector<bool> marked(n, false);
+	std::vector<bool> moved(n, false);
+	for (auto& u : touched) {
+		if (u < n) {
+			marked[u] = true;
+		}
+	}
+	for (auto& u : changed) {
+		if (u < n) {
+			marked[u] = moved[u] = true;
+		}
+	}
+	for (unsigned int rank = 0; rank < order_.size(); ++rank) {
+		unsigned int v = order_[rank];
+		if (v < n && !moved[v]) {
+			continue;
+		}
+		for (unsigned int i = offsets_[v]; i < offsets_[v + 1]; ++i) {
+			if (arcs_[i].target < n) {
+				marked[arcs_[i].target] = true;
+			}
+		}
+		for (unsigned int i = added_offsets_[rank]; 
+				 i < added_offsets_[rank + 1]; ++i) {
+			if (added_[i].from < n) {
+				marked[added_[i].from] = true;
+			}
+			if (added_[i].to < n) {
+				marked[added_[i].to] = true;
+			}
+		}
+	}
+
+	std::vector<unsigned int> order;
+	std::vector<double> priorities;
+	std::vector<unsigned int> added_offsets(1, 0), reached_offsets(1, 0);
+	std::vector<Shortcut> added, before, after, differ;
+	std::vector<unsigned int> reached;
+	std::vector<unsigned int> old_ranks(n, 0);
+	ranks_.swap(old_ranks);
+	Contraction c;
+	start(c);
+	std::vector<Entry> pending;
+	for (unsigned int v = 0; v < n; ++v) {
+		if (moved[v] || v >= old_n) {
+			moved[v] = marked[v] = true;
+			pending.push_back(Entry(priority(c, v), v));
+		}
+	}
+	std::make_heap(pending.begin(), pending.end(), later);
+
+	unsigned int next = 0;
+	while (order.size() < n) {
+		while (next < order_.size() && 
+					 (order_[next] >= n || moved[order_[next]])) {
+			++next;
+		}
+		bool fixed = next < order_.size();
+
+		//	a changed node goes before the next of the others once its priority
+		//	is no more than that one's was, brought up to date as in build
+		unsigned int v = 0;
+		double current = 0;
+		bool placed = false;
+		if (!pending.empty() && 
+				(!fixed || pending.front().first <= priorities_[next])) {
+			std::pop_heap(pending.begin(), pending.end(), later);
+			v = pending.back().second;
+			pending.pop_back();
+			current = priority(c, v);
+			if ((!pending.empty() && current > pending.front().first) ||
+					(fixed && current > priorities_[next])) {
+				pending.push_back(Entry(current, v));
+				std::push_heap(pending.begin(), pending.end(), later);
+				continue;
+			}
+			placed = true;
+		}
+
+		unsigned int old_rank = 0;
+		bool again = placed;
+		if (!placed) {
+			old_rank = next++;
+			v = order_[old_rank];
+			current = priorities_[old_rank];
+			again = marked[v];
+			for (unsigned int i = reached_offsets_[old_rank]; 
+					 !again && i < reached_offsets_[old_rank + 1]; ++i) {
+				again = reached_[i] >= n || marked[reached_[i]];
+			}
+		}
+		ranks_[v] = order.size();
+		order.push_back(v);
+		priorities.push_back(current);
+
+		if (again) {
+			//	the ends of the shortcuts that changed, and the neighbors of a 
+			//	changed node, have gained or lost edges for the nodes contracted
+			//	after this one
+			unsigned int first = added.size();
+			contract(c, v, &added, &reached);
+			after.assign(added.begin() + first, added.end());
+			before.clear();
+			if (!placed) {
+				before.assign(added_.begin() + added_offsets_[old_rank], 
+											added_.begin() + added_offsets_[old_rank + 1]);
+			}
+			std::sort(before.begin(), before.end());
+			std::sort(after.begin(), after.end());
+			differ.clear();
+			std::set_symmetric_difference(before.begin(), before.end(), 
+																		after.begin(), after.end(),
+																		std::back_inserter(differ));
+			for (auto& shortcut : differ) {
+				if (shortcut.from < n) {
+					marked[shortcut.from] = true;
+				}
+				if (shortcut.to < n) {
+					marked[shortcut.to] = true;
+				}
+			}
+			for (unsigned int i = 0; placed && i < c.remaining[v].size(); ++i) {
+				marked[c.remaining[v][i].target] = true;
+			}
+		} else {
+			for (unsigned int i = added_offsets_[old_rank]; 
+					 i < added_offsets_[old_rank + 1]; ++i) {
+				add_shortcut(c, v, added_[i]);
+				added.push_back(added_[i]);
+			}
+			reached.insert(reached.end(), 
+										 reached_.begin() + reached_offsets_[old_rank],
+										 reached_.begin() + reached_offsets_[old_rank + 1]);
+		}
+		added_offsets.push_back(added.size());
+		reached_offsets.push_back(reached.size());
+		remove(c, v);
+	}
+	order_.swap(order);
+	priorities_.swap(priorities);
+	added_offsets_.swap(added_offsets);
+	added_.swap(added);
+	reached_offsets_.swap(reached_offsets);
+	reached_.swap(reached);
+	finish(c);
+}
+
+bool ContractionHierarchy::built() const {
+	return graph_ != NULL;
+}
+
+unsigned int ContractionHierarchy::shortcuts() const {
+	return shortcuts_;
+}
+
+unsigned int ContractionHierarchy::rank(unsigned int node) const {
+	return ranks_[node];
+}
+
+bool ContractionHierarchy::shortest_path(unsigned int from, unsigned int to,
+																				 QueryScratch& scratch) const {
+	//	the forward search uses entries [0, n) of costs and previous, and the
+	//	backward search uses entries [n, 2n); both share one queue
+	unsigned int n = ranks_.size();
+	std::vector<double>& costs = scratch.costs;
+	std::vector<unsigned int>& previous = scratch.previous;
+	std::vector< std::pair<double, unsigned int> >& queue = scratch.queue;
+	std::greater< std::pair<double, unsigned int> > later;
+	costs.assign(2 * n, HUGE_VAL);
+	previous.resize(2 * n);
+	queue.clear();
+	scratch.stations.clear();
+	scratch.route_lines.clear();
+	scratch.distance = HUGE_VAL;
+
+	costs[from] = 0;
+	previous[from] = from;
+	costs[n + to] = 0;
+	previous[n + to] = to;
+	queue.push_back(std::make_pair(0.0, from));
+	queue.push_back(std::make_pair(0.0, n + to));
+	std::make_heap(queue.begin(), queue.end(), later);
+
+	double best = HUGE_VAL;
+	unsigned int meet = n;
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), later);
+		std::pair<double, unsigned int> next = queue.back();
+		queue.pop_back();
+		if (next.first >= best) {
+			//	neither search can find anything faster
+			break;
+		}
+		if (next.first > costs[next.second]) {
+			continue;
+		}
+		++scratch.probes;
+		unsigned int side = next.second / n;
+		unsigned int u = next.second % n;
+		double other = costs[(1 - side) * n + u];
+		if (next.first + other < best) {
+			best = next.first + other;
+			meet = u;
+		}
+		for (unsigned int i = offsets_[u]; i < offsets_[u + 1]; ++i) {
+			const Arc& arc = arcs_[i];
+			unsigned int v = side * n + arc.target;
+			double cost = next.first + arc.minutes;
+			if (cost < costs[v]) {
+				costs[v] = cost;
+				previous[v] = u;
+				queue.push_back(std::make_pair(cost, v));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+		}
+	}
+	if (meet == n) {
+		return false;
+	}
+
+	//	the forward half of the route, from the meeting node back to from
+	std::vector<unsigned int> half;
+	for (unsigned int u = meet; u != from; u = previous[u]) {
+		half.push_back(u);
+	}
+	half.push_back(from);
+	std::reverse(half.begin(), half.end());
+
+	scratch.stations.push_back(graph_->station(from));
+	scratch.route_lines.push_back(0UL);
+	for (unsigned int i = 1; i < half.size(); ++i) {
+		unpack(half[i - 1], half[i], scratch);
+	}
+	for (unsigned int u = meet; u != to; u = previous[n + u]) {
+		unpack(u, previous[n + u], scratch);
+	}
+	scratch.distance = best;
+	return true;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+bool ContractionHierarchy::Shortcut::operator<(const Shortcut& other) const {
+	if (from != other.from) {
+		return from < other.from;
+	}
+	if (to != other.to) {
+		return to < other.to;
+	}
+	return minutes < other.minutes;
+}
+
+void ContractionHierarchy::start(Contraction& c) const {
+	unsigned int n = graph_->nodes();
+	c.remaining.assign(n, std::vector<Arc>());
+	for (unsigned int u = 0; u < n; ++u) {
+		for (const RouteGraph::Edge* e = graph_->begin(u); e != graph_->end(u); 
+				 ++e) {
+			Arc arc = { e->target, e->minutes, -1, e->lines };
+			c.remaining[u].push_back(arc);
+		}
+	}
+	c.upward.assign(n, std::vector<Arc>());
+	c.contracted_neighbors.assign(n, 0);
+	c.costs.assign(n, HUGE_VAL);
+	c.touched.clear();
+	c.queue.clear();
+}
+
+double ContractionHierarchy::priority(Contraction& c, unsigned int v) const {
+	//	a node's priority is the number of edges contracting it would add minus
+	//	the number it would remove, plus its contracted neighbors so that the
+	//	contracted nodes are spread evenly over the graph
+	return (double)contract(c, v, NULL, NULL) - (double)c.remaining[v].size() +
+				 c.contracted_neighbors[v];
+}
+
+int ContractionHierarchy::contract(Contraction& c, unsigned int v,
+																	 std::vector<Shortcut>* added,
+																	 std::vector<unsigned int>* reached) const {
+	typedef std::pair<double, unsigned int> Entry;
+	std::greater<Entry> later;
+	int count = 0;
+	unsigned int first = reached ? reached->size() : 0;
+	std::vector<Arc> around = c.remaining[v];
+	double farthest = 0;
+	for (auto& arc : around) {
+		farthest = std::max(farthest, arc.minutes);
+	}
+	for (auto& from : around) {
+		//	search from this neighbor without v, no farther than any path
+		//	through v can be
+		double limit = from.minutes + farthest;
+		c.costs[from.target] = 0;
+		c.touched.push_back(from.target);
+		c.queue.push_back(Entry(0, from.target));
+		while (!c.queue.empty()) {
+			std::pop_heap(c.queue.begin(), c.queue.end(), later);
+			Entry next = c.queue.back();
+			c.queue.pop_back();
+			if (next.first > c.costs[next.second] || next.first > limit) {
+				continue;
+			}
+			if (reached) {
+				reached->push_back(next.second);
+			}
+			for (auto& arc : c.remaining[next.second]) {
+				double cost = next.first + arc.minutes;
+				if (arc.target != v && cost < c.costs[arc.target]) {
+					if (c.costs[arc.target] == HUGE_VAL) {
+						c.touched.push_back(arc.target);
+					}
+					c.costs[arc.target] = cost;
+					c.queue.push_back(Entry(cost, arc.target));
+					std::push_heap(c.queue.begin(), c.queue.end(), later);
+				}
+			}
+		}
+
+		for (auto& to : around) {
+			double through = from.minutes + to.minutes;
+			if (to.target <= from.target || c.costs[to.target] <= through) {
+				continue;
+			}
+			++count;
+			if (added) {
+				Shortcut shortcut = { from.target, to.target, through };
+				add_shortcut(c, v, shortcut);
+				added->push_back(shortcut);
+			}
+		}
+
+		for (auto& t : c.touched) {
+			c.costs[t] = HUGE_VAL;
+		}
+		c.touched.clear();
+		c.queue.clear();
+	}
+	if (reached) {
+		std::sort(reached->begin() + first, reached->end());
+		reached->erase(std::unique(reached->begin() + first, reached->end()),
+									 reached->end());
+	}
+	return count;
+}
+
+void ContractionHierarchy::add_shortcut(Contraction& c, unsigned int v,
+																				const Shortcut& shortcut) const {
+	unsigned int ends[2] = { shortcut.from, shortcut.to };
+	for (int i = 0; i < 2; ++i) {
+		std::vector<Arc>& arcs = c.remaining[ends[i]];
+		Arc arc = { ends[1 - i], shortcut.minutes, (int)v, 0UL };
+		bool found = false;
+		for (auto& a : arcs) {
+			if (a.target == arc.target) {
+				found = true;
+				if (a.minutes > arc.minutes) {
+					a = arc;
+				}
+			}
+		}
+		if (!found) {
+			arcs.push_back(arc);
+		}
+	}
+}
+
+void ContractionHierarchy::remove(Contraction& c, unsigned int v) const {
+	c.upward[v] = c.remaining[v];
+	for (auto& arc : c.remaining[v]) {
+		std::vector<Arc>& arcs = c.remaining[arc.target];
+		for (unsigned int i = 0; i < arcs.size(); ++i) {
+			if (arcs[i].target == v) {
+				arcs[i] = arcs.back();
+				arcs.pop_back();
+				break;
+			}
+		}
+		++c.contracted_neighbors[arc.target];
+	}
+	c.remaining[v].clear();
+}
+
+void ContractionHierarchy::finish(Contraction& c) {
+	unsigned int n = c.upward.size();
+	shortcuts_ = added_.size();
+	offsets_.assign(n + 1, 0);
+	arcs_.clear();
+	for (unsigned int v = 0; v < n; ++v) {
+		arcs_.insert(arcs_.end(), c.upward[v].begin(), c.upward[v].end());
+		offsets_[v + 1] = arcs_.size();
+	}
+}
+
+const ContractionHierarchy::Arc& ContractionHierarchy::find_arc(unsigned int a,
+																										 unsigned int b) const {
+	if (ranks_[a] > ranks_[b]) {
+		std::swap(a, b);
+	}
+	unsigned int i = offsets_[a];
+	while (arcs_[i].target != b) {
+		++i;
+	}
+	return arcs_[i];
+}
+
+void ContractionHierarchy::unpack(unsigned int a, unsigned int b,
+																	QueryScratch& scratch) const {
+	const Arc& arc = find_arc(a, b);
+	if (arc.middle < 0) {
+		scratch.stations.push_back(graph_->station(b));
+		scratch.route_lines.push_back(arc.lines);
+	} else {
+		unpack(a, arc.middle, scratch);
+		unpack(arc.middle, b, scratch);
+	}
+}
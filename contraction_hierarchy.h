@@ -0,0 +1,196 @@
+/*******************************************************************************
+  Title          : contraction_hierarchy.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the ContractionHierarchy class
+  Purpose        : To find the fastest route between two subway stations in
+									 less time than searching the whole RouteGraph
+  Usage          : Build a ContractionHierarchy object from a RouteGraph
+									 object and call shortest_path with the nodes of two
+									 stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __CONTRACTION_HIERARCHY_H__
+#define __CONTRACTION_HIERARCHY_H__
+
+#include <vector>
+#include "route_graph.h"
+#include "query_scratch.h"
+
+/*******************************************************************************
+
+		The ContractionHierarchy class is a preprocessed form of a RouteGraph that
+		answers the same shortest path queries by searching only a small part of
+		the graph. Building it contracts the nodes one at a time, least important
+		first: a node is removed from the graph, and wherever the fastest way
+		between two of its neighbors went through it, a shortcut edge with the
+		same travel time is added between them. A node's importance is estimated
+		by how many shortcuts contracting it would add minus how many edges it
+		removes, and its rank is its position in the order of contraction.
+
+		Every route in the graph has a fastest version that only goes up in rank
+		and then only down, using shortcuts to skip the nodes in between. So a
+		query searches upward from both ends at the same time, in a graph that
+		only keeps the edges that lead to a higher rank, and the best place where
+		the two searches meet gives the travel time. Shortcuts remember the node
+		they skip, which is how the stations of the route are found again.
+
+		When RouteGraph::update changes some stations, update repairs the
+		hierarchy instead of building it again. The other nodes keep their 
+		order, and each changed node is put in it where its priority, in the
+		graph left at that point, is no more than the priority the next node
+		had when it was contracted. Contracting a node only depends on the 
+		edges its witness searches follow, so each node's shortcuts and the 
+		nodes whose edges its searches followed are kept, and a node is only
+		contracted again if it or one of those nodes gained or lost edges,
+		either in the graph or from the shortcuts of a node contracted again
+		before it; the others add the same shortcuts as before.
+
+		The graph is undirected, so both searches use the same upward edges. A
+		built ContractionHierarchy is never modified by a search, so any number
+		of threads can search it at the same time, as long as each thread uses
+		its own QueryScratch object.
+
+*******************************************************************************/
+
+class ContractionHierarchy {
+ public:
+	//	Creates an empty ContractionHierarchy object
+	ContractionHierarchy();
+
+	//	Destroys ContractionHierarchy object
+	~ContractionHierarchy();
+
+	//	Builds the hierarchy of graph, replacing the previous one, if any. graph
+	//	must exist for as long as the hierarchy is used
+	void build(const RouteGraph& graph);
+
+	//	Repairs the hierarchy after the graph it was built from has been 
+	//	updated, where changed holds the nodes whose stations changed, as 
+	//	RouteGraph::update was given them, and touched holds the nodes whose
+	//	edges may have changed, as RouteGraph::update sets it
+	void update(const std::vector<unsigned int>& changed,
+							const std::vector<unsigned int>& touched);
+
+	//	Returns true if the hierarchy has been built
+	bool built() const;
+
+	//	Returns the number of shortcuts that were added
+	unsigned int shortcuts() const;
+
+	//	Returns the rank of node; the node contracted first has rank 0
+	unsigned int rank(unsigned int node) const;
+
+	//	Finds the fastest route from node from to node to, and sets scratch
+	//	the same way as RouteGraph::shortest_path does. The travel time is the
+	//	same as RouteGraph::shortest_path finds, but when several routes are
+	//	equally fast, a different one may be chosen. Adds the number of nodes
+	//	visited by both searches to scratch.probes
+	bool shortest_path(unsigned int from, unsigned int to,
+										 QueryScratch& scratch) const;
+
+ private:
+	//	An edge to a node of higher rank
+	struct Arc {
+		//	The node the edge leads to
+		unsigned int target;
+
+		//	The number of minutes it takes to travel the edge
+		double minutes;
+
+		//	The node the shortcut skips, or -1 if the edge is in the RouteGraph
+		int middle;
+
+		//	The lines that ride the edge, if it is in the RouteGraph
+		unsigned long lines;
+	};
+
+	//	A shortcut added by contracting a node, between two of its neighbors
+	struct Shortcut {
+		unsigned int from;
+		unsigned int to;
+		double minutes;
+
+		bool operator<(const Shortcut& other) const;
+	};
+
+	//	The graph left while the nodes are contracted, which loses a node and
+	//	its edges at each step, and the working storage of the witness searches
+	struct Contraction {
+		std::vector< std::vector<Arc> > remaining;
+		std::vector< std::vector<Arc> > upward;
+		std::vector<unsigned int> contracted_neighbors;
+		std::vector<double> costs;
+		std::vector<unsigned int> touched;
+		std::vector< std::pair<double, unsigned int> > queue;
+	};
+
+	ContractionHierarchy(const ContractionHierarchy&);
+	ContractionHierarchy& operator=(const ContractionHierarchy&);
+
+	//	The graph the hierarchy was built from
+	const RouteGraph* graph_;
+
+	//	The rank of each node
+	std::vector<unsigned int> ranks_;
+
+	//	The upward edges leaving node n are arcs_[offsets_[n]] to
+	//	arcs_[offsets_[n + 1] - 1]
+	std::vector<unsigned int> offsets_;
+	std::vector<Arc> arcs_;
+
+	//	The nodes in the order they were contracted, and the priority each one
+	//	had when it was
+	std::vector<unsigned int> order_;
+	std::vector<double> priorities_;
+
+	//	The shortcuts added by contracting the node of rank r are 
+	//	added_[added_offsets_[r]] to added_[added_offsets_[r + 1] - 1], and
+	//	the nodes whose edges its witness searches followed are listed the 
+	//	same way in reached_
+	std::vector<unsigned int> added_offsets_;
+	std::vector<Shortcut> added_;
+	std::vector<unsigned int> reached_offsets_;
+	std::vector<unsigned int> reached_;
+
+	//	The number of shortcuts in the hierarchy
+	unsigned int shortcuts_;
+
+	//	Sets up c to contract the nodes of graph_
+	void start(Contraction& c) const;
+
+	//	Returns the priority of contracting v next in c
+	double priority(Contraction& c, unsigned int v) const;
+
+	//	Visits the pairs of v's neighbors in c whose fastest connection goes
+	//	through v, and returns their number. If added is not NULL, adds a 
+	//	shortcut between each pair, appends it to added, and appends the nodes
+	//	whose edges the searches followed to reached
+	int contract(Contraction& c, unsigned int v, std::vector<Shortcut>* added,
+							 std::vector<unsigned int>* reached) const;
+
+	//	Adds the shortcut through v in both directions, or makes an existing
+	//	edge between its ends as fast as it
+	void add_shortcut(Contraction& c, unsigned int v, 
+										const Shortcut& shortcut) const;
+
+	//	Takes v and its edges out of the graph left in c, keeping the edges 
+	//	as v's upward edges
+	void remove(Contraction& c, unsigned int v) const;
+
+	//	Packs the upward edges of c into offsets_ and arcs_
+	void finish(Contraction& c);
+
+	//	Returns the upward edge from the lower ranked of a and b to the other
+	const Arc& find_arc(unsigned int a, unsigned int b) const;
+
+	//	Appends the stations after a on the edge from a to b, and the lines that
+	//	reach them, to scratch, replacing shortcuts with the edges they skip
+	void unpack(unsigned int a, unsigned int b, QueryScratch& scratch) const;
+};
+
+#endif
+
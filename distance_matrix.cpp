@@ -0,0 +1,206 @@
+/*******************************************************************************
+  Title          : distance_matrix.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the DistanceMatrix class
+  Purpose        : To provide the distance between every pair of subway
+									 stations without recomputing it on every run
+  Usage          : Load a DistanceMatrix object from its file with load, or
+									 build it from a SubwaySystem object's stations and save it,
+									 then call distance with the positions of two stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "distance_matrix.h"
+#include "haversine.h"
+#include <algorithm>
+#include <fstream>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//	The first bytes of a distance matrix file, and the version of its layout
+static const char kMagic[8] = { 'S', 'U', 'B', 'W', 'A', 'Y', 'D', 'M' };
+static const uint32_t kVersion = 1;
+
+DistanceMatrix::DistanceMatrix() : size_(0), blocks_(0), fingerprint_(0),
+    data_(NULL), distances_(), mapping_(NULL), mapping_size_(0)
+{
+}
+
+DistanceMatrix::~DistanceMatrix() {
+	clear();
+}
+
+void DistanceMatrix::build(const std::vector<const SubwayStation*>& stations,
+													 WorkPool& pool) {
+	clear();
+	size_ = stations.size();
+	blocks_ = (size_ + kBlock - 1) / kBlock;
+	fingerprint_ = fingerprint(stations);
+	distances_.assign(blocks_ * (blocks_ + 1) / 2 * kBlock * kBlock, 0.0f);
+	data_ = distances_.data();
+
+	//	points on the unit sphere, padded with zeros to a whole number of blocks
+	unsigned int padded = blocks_ * kBlock;
+	std::vector<double> x(padded, 0), y(padded, 0), z(padded, 0);
+	for (unsigned int i = 0; i < size_; ++i) {
+		double lat, lon;
+		stations[i]->get_coordinates(lat, lon);
+		lat *= TO_RAD;
+		lon *= TO_RAD;
+		x[i] = cos(lat) * cos(lon);
+		y[i] = cos(lat) * sin(lon);
+		z[i] = sin(lat);
+	}
+
+	float* distances = distances_.data();
+	pool.parallel_for(0, blocks_, 1,
+		[&](unsigned int, unsigned int first, unsigned int last) {
+			double chords[kBlock];
+			for (unsigned int r = first; r < last; ++r) {
+				for (unsigned int c = 0; c <= r; ++c) {
+					float* block = distances + (r * (r + 1) / 2 + c) * kBlock * kBlock;
+					const double* xs = &x[c * kBlock];
+					const double* ys = &y[c * kBlock];
+					const double* zs = &z[c * kBlock];
+					for (unsigned int i = 0; i < kBlock; ++i) {
+						double xi = x[r * kBlock + i];
+						double yi = y[r * kBlock + i];
+						double zi = z[r * kBlock + i];
+						for (unsigned int j = 0; j < kBlock; ++j) {
+							double dx = xi - xs[j];
+							double dy = yi - ys[j];
+							double dz = zi - zs[j];
+							chords[j] = sqrt(dx * dx + dy * dy + dz * dz);
+						}
+						for (unsigned int j = 0; j < kBlock; ++j) {
+							block[i * kBlock + j] = 
+									(float)(asin(std::min(chords[j] / 2, 1.0)) * 2 * RA);
+						}
+					}
+				}
+			}
+		});
+}
+
+bool DistanceMatrix::load(const std::string& path,
+													const std::vector<const SubwayStation*>& stations) {
+	clear();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+			(size_t)info.st_size < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+	void* mapping = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	const Header* header = (const Header*)mapping;
+	unsigned int blocks = (stations.size() + kBlock - 1) / kBlock;
+	size_t expected = sizeof(Header) + 
+										sizeof(float) * blocks * (blocks + 1) / 2 * kBlock * kBlock;
+	if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+			header->version != kVersion || header->stations != stations.size() ||
+			header->block != kBlock || 
+			header->fingerprint != fingerprint(stations) ||
+			(size_t)info.st_size != expected) {
+		munmap(mapping, info.st_size);
+		return false;
+	}
+	mapping_ = mapping;
+	mapping_size_ = info.st_size;
+	size_ = stations.size();
+	blocks_ = blocks;
+	fingerprint_ = header->fingerprint;
+	data_ = (const float*)((const char*)mapping + sizeof(Header));
+	return true;
+}
+
+bool DistanceMatrix::save(const std::string& path) const {
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.stations = size_;
+	header.block = kBlock;
+	header.fingerprint = fingerprint_;
+
+	//	the matrix is written under another name and then renamed, so another
+	//	run never maps a file that is only partly written
+	std::string temporary = path + ".tmp";
+	std::ofstream file(temporary.c_str(), std::ios::binary | std::ios::trunc);
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)data_, sizeof(float) * blocks_ * (blocks_ + 1) / 2 *
+																 kBlock * kBlock);
+	file.close();
+	if (!file || rename(temporary.c_str(), path.c_str()) != 0) {
+		remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+void DistanceMatrix::clear() {
+	if (mapping_) {
+		munmap(mapping_, mapping_size_);
+	}
+	mapping_ = NULL;
+	mapping_size_ = 0;
+	distances_.clear();
+	data_ = NULL;
+	size_ = 0;
+	blocks_ = 0;
+	fingerprint_ = 0;
+}
+
+float DistanceMatrix::distance(unsigned int from, unsigned int to) const {
+	if (from < to) {
+		std::swap(from, to);
+	}
+	unsigned int r = from / kBlock;
+	unsigned int c = to / kBlock;
+	return data_[((r * (r + 1) / 2 + c) * kBlock + from % kBlock) * kBlock +
+							 to % kBlock];
+}
+
+unsigned int DistanceMatrix::size() const {
+	return size_;
+}
+
+bool DistanceMatrix::mapped() const {
+	return mapping_ != NULL;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+uint64_t DistanceMatrix::fingerprint(
+    const std::vector<const SubwayStation*>& stations) {
+	//	64-bit FNV-1a hash of the bytes of every latitude and longitude
+	uint64_t hash = 14695981039346656037ULL;
+	for (auto& s : stations) {
+		double coordinates[2];
+		s->get_coordinates(coordinates[0], coordinates[1]);
+		const unsigned char* bytes = (const unsigned char*)coordinates;
+		for (unsigned int i = 0; i < sizeof(coordinates); ++i) {
+			hash = (hash ^ bytes[i]) * 1099511628211ULL;
+		}
+	}
+	return hash;
+}
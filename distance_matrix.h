@@ -0,0 +1,129 @@
+/*******************************************************************************
+  Title          : distance_matrix.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the DistanceMatrix class
+  Purpose        : To provide the distance between every pair of subway
+									 stations without recomputing it on every run
+  Usage          : Load a DistanceMatrix object from its file with load, or
+									 build it from a SubwaySystem object's stations and save it,
+									 then call distance with the positions of two stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __DISTANCE_MATRIX_H__
+#define __DISTANCE_MATRIX_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "subway_entrance.h"
+#include "subway_station.h"
+#include "work_pool.h"
+
+/*******************************************************************************
+
+		The DistanceMatrix class holds the great circle distance in kilometers 
+		between every pair of stations, as 32-bit floats. The matrix is 
+		symmetric, so only its lower triangle is kept, cut into square blocks of
+		kBlock by kBlock distances: block (r, c), with c <= r, holds the distances
+		from stations kBlock * r to kBlock * r + kBlock - 1 to stations kBlock * c 
+		to kBlock * c + kBlock - 1, row by row, and the blocks are stored one 
+		after another in the order (0, 0), (1, 0), (1, 1), (2, 0) and so on. A 
+		block is small enough to stay in the cache while it is filled or read.
+
+		Building the matrix computes each row of blocks as a separate task of a
+		WorkPool. The stations' coordinates are first turned into points on a 
+		unit sphere, kept in separate arrays of x, y and z, so that the inner loop
+		over a block's columns is plain arithmetic that the compiler can turn 
+		into vector instructions. The straight-line distance between two points 
+		gives the great circle distance in the same way as the dist function of
+		haversine.h.
+
+		A built matrix can be saved to a file, which starts with a header that 
+		records the number of stations, the block size and a fingerprint of the
+		stations' coordinates, followed by the blocks exactly as they are kept in
+		memory. Loading maps the file into memory instead of reading it, so the 
+		distances are read from the file as they are used, and a file whose 
+		header does not match the stations is refused. The file is in the byte 
+		order of the machine that saved it.
+
+*******************************************************************************/
+
+class DistanceMatrix {
+ public:
+	//	Number of rows and columns of stations in a block
+	static const unsigned int kBlock = 16;
+
+	//	Creates an empty DistanceMatrix object
+	DistanceMatrix();
+
+	//	Destroys DistanceMatrix object
+	~DistanceMatrix();
+
+	//	Computes the distances between stations, replacing the previous matrix,
+	//	if any, using the workers of pool
+	void build(const std::vector<const SubwayStation*>& stations, WorkPool& pool);
+
+	//	Replaces the matrix with the one saved in the file at path. Returns 
+	//	false, leaving the matrix empty, if the file cannot be read or was not
+	//	saved for stations
+	bool load(const std::string& path,
+						const std::vector<const SubwayStation*>& stations);
+
+	//	Writes the matrix to the file at path. Returns false if it cannot be 
+	//	written
+	bool save(const std::string& path) const;
+
+	//	Removes every distance from DistanceMatrix object
+	void clear();
+
+	//	Returns the distance in kilometers between the stations at positions 
+	//	from and to of the vector the matrix was built from
+	float distance(unsigned int from, unsigned int to) const;
+
+	//	Returns the number of stations
+	unsigned int size() const;
+
+	//	Returns true if the distances are read from a file
+	bool mapped() const;
+
+ private:
+	//	The beginning of the file, before the blocks
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t stations;
+		uint32_t block;
+		uint32_t reserved;
+		uint64_t fingerprint;
+	};
+
+	DistanceMatrix(const DistanceMatrix&);
+	DistanceMatrix& operator=(const DistanceMatrix&);
+
+	//	Number of stations
+	unsigned int size_;
+
+	//	Number of rows of blocks
+	unsigned int blocks_;
+
+	//	Fingerprint of the stations' coordinates
+	uint64_t fingerprint_;
+
+	//	The blocks, which are either in distances_ or in the mapped file
+	const float* data_;
+	std::vector<float> distances_;
+
+	//	The mapped file and its size in bytes, if the matrix was loaded
+	void* mapping_;
+	size_t mapping_size_;
+
+	//	Returns the fingerprint of the coordinates of stations, in order
+	static uint64_t fingerprint(const std::vector<const SubwayStation*>& stations);
+};
+
+#endif
+
@@ -0,0 +1,97 @@
+/*******************************************************************************
+  Title          : entrance_grid.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the EntranceGrid class
+  Purpose        : To find the entrances that may be within a fixed distance
+									 of a point without looking at every entrance
+  Usage          : Create an EntranceGrid object with the distance, insert
+									 numbered points into it and call candidates with a
+									 latitude and longitude point
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "entrance_grid.h"
+#include "haversine.h"
+#include <algorithm>
+
+EntranceGrid::EntranceGrid(double radius) : radius_(radius),
+    cell_(radius / (RA * TO_RAD)), size_(0), cells_()
+{
+}
+
+EntranceGrid::~EntranceGrid()
+{
+}
+
+void EntranceGrid::insert(unsigned int id, double latitude, double longitude) {
+	cells_[key(cell(latitude), cell(longitude))].push_back(id);
+	++size_;
+}
+
+bool EntranceGrid::remove(unsigned int id, double latitude, double longitude) {
+	auto found = cells_.find(key(cell(latitude), cell(longitude)));
+	if (found == cells_.end()) {
+		return false;
+	}
+	std::vector<unsigned int>& ids = found->second;
+	auto i = std::find(ids.begin(), ids.end(), id);
+	if (i == ids.end()) {
+		return false;
+	}
+	*i = ids.back();
+	ids.pop_back();
+	if (ids.empty()) {
+		cells_.erase(found);
+	}
+	--size_;
+	return true;
+}
+
+void EntranceGrid::clear() {
+	cells_.clear();
+	size_ = 0;
+}
+
+void EntranceGrid::candidates(double latitude, double longitude,
+															std::vector<unsigned int>& ids) const {
+	ids.clear();
+	//	a point within radius_ is at most cell_ degrees of latitude away, so in
+	//	the next row at most. Its distance is at least what the longitude
+	//	difference alone makes at the smallest cosine of latitude in those rows,
+	//	which bounds the number of columns to look at
+	double c = cos(TO_RAD * latitude) *
+						 cos(TO_RAD * std::min(90.0, fabs(latitude) + cell_));
+	double s = c > 0 ? sin(radius_ / (2 * RA)) / sqrt(c) : 1;
+	long columns = s < 1 ? (long)ceil(2 * asin(s) / TO_RAD / cell_)
+											 : (long)ceil(360 / cell_);
+	long row = cell(latitude), column = cell(longitude);
+	for (long r = row - 1; r <= row + 1; ++r) {
+		for (long k = column - columns; k <= column + columns; ++k) {
+			auto found = cells_.find(key(r, k));
+			if (found != cells_.end()) {
+				ids.insert(ids.end(), found->second.begin(), found->second.end());
+			}
+		}
+	}
+}
+
+unsigned int EntranceGrid::size() const {
+	return size_;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+long EntranceGrid::cell(double degrees) const {
+	return (long)floor(degrees / cell_);
+}
+
+uint64_t EntranceGrid::key(long row, long column) {
+	return ((uint64_t)(uint32_t)row << 32) | (uint32_t)column;
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+  Title          : entrance_grid.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the EntranceGrid class
+  Purpose        : To find the entrances that may be within a fixed distance
+									 of a point without looking at every entrance
+  Usage          : Create an EntranceGrid object with the distance, insert
+									 numbered points into it and call candidates with a
+									 latitude and longitude point
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __ENTRANCE_GRID_H__
+#define __ENTRANCE_GRID_H__
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/*******************************************************************************
+
+		The EntranceGrid class is a uniform grid of latitude and longitude cells
+		whose sides are radius kilometers long in latitude, and at least that
+		long in longitude, so that every point within radius of a point is in
+		its cell's row or in one of the two rows next to it, and in a few
+		columns on each side that depend on how far from the equator the point
+		is. Only the cells that hold points are stored, in a hash map keyed by
+		their row and column, so the grid takes space proportional to the
+		number of points however far apart they are. Inserting, removing and
+		finding the points near a point each take time proportional to the
+		number of points in the cells around it, not to the number of points in
+		the grid.
+
+		SubwaySystem uses an EntranceGrid to find the entrances that a new
+		entrance could share a station with, which must be within 0.28 km of it.
+		The points are numbered by the caller, and each number must be inserted
+		at most once.
+
+*******************************************************************************/
+
+class EntranceGrid {
+ public:
+	//	Creates an empty EntranceGrid object for finding points within radius
+	//	kilometers
+	explicit EntranceGrid(double radius);
+
+	//	Destroys EntranceGrid object
+	~EntranceGrid();
+
+	//	Adds the point numbered id at the given latitude and longitude
+	void insert(unsigned int id, double latitude, double longitude);
+
+	//	Removes the point numbered id, which must have been inserted at the
+	//	given latitude and longitude. Returns false if it is not in the grid
+	bool remove(unsigned int id, double latitude, double longitude);
+
+	//	Removes every point
+	void clear();
+
+	//	Replaces the contents of ids with the numbers of every point in the
+	//	cells that may hold points within radius of the given latitude and
+	//	longitude, in no particular order. Points farther away than radius can
+	//	be among them, so the caller measures each one
+	void candidates(double latitude, double longitude,
+									std::vector<unsigned int>& ids) const;
+
+	//	Returns the number of points in the grid
+	unsigned int size() const;
+
+ private:
+	//	Distance in kilometers that candidates must find every point within
+	double radius_;
+
+	//	Side of a cell in degrees
+	double cell_;
+
+	//	Number of points in the grid
+	unsigned int size_;
+
+	//	The numbers of the points in each cell that holds any, keyed by the
+	//	cell's row and column
+	std::unordered_map< uint64_t, std::vector<unsigned int> > cells_;
+
+	//	Returns the row or the column of the cell that degrees falls in
+	long cell(double degrees) const;
+
+	//	Returns the key of the cell at row and column in cells_
+	static uint64_t key(long row, long column);
+};
+
+#endif
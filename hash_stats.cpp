@@ -0,0 +1,65 @@
+/*******************************************************************************
+  Title          : hash_stats.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the HashStats struct
+  Purpose        : To find out how well the hash tables of the subway system
+									 spread their entries
+  Usage          : Call statistics on a HashTable object and display the
+									 result
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "hash_stats.h"
+#include <iomanip>
+
+HashStats::HashStats(unsigned int capacity) : capacity(capacity), entries(0),
+    deleted(0), probes(), chains(), miss_probes(0), longest_chain()
+{
+}
+
+double HashStats::load_factor() const {
+	return capacity ? (double)entries / capacity : 0;
+}
+
+double HashStats::mean_probes() const {
+	unsigned long total = 0;
+	for (unsigned int k = 0; k < probes.size(); ++k) {
+		total += (k + 1) * (unsigned long)probes[k];
+	}
+	return entries ? (double)total / entries : 0;
+}
+
+double HashStats::mean_miss_probes() const {
+	return capacity ? (double)miss_probes / capacity : 0;
+}
+
+void HashStats::display(std::ostream& out, const std::string& table) const {
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+	out << std::fixed << std::setprecision(3);
+	out << table << ": " << entries << " entries, " << deleted << " deleted, ";
+	out << capacity << " slots, load factor " << load_factor() << std::endl;
+	out << "  probes per hit:  mean " << mean_probes() << ", histogram";
+	for (unsigned int k = 0; k < probes.size(); ++k) {
+		out << " " << k + 1 << ":" << probes[k];
+	}
+	out << std::endl;
+	out << "  probes per miss: mean " << mean_miss_probes() << std::endl;
+	out << "  entries per home slot:";
+	for (unsigned int k = 0; k < chains.size(); ++k) {
+		out << " " << k + 1 << ":" << chains[k];
+	}
+	out << std::endl;
+	if (longest_chain.size() > 1) {
+		out << "  longest chain:";
+		for (unsigned int i = 0; i < longest_chain.size(); ++i) {
+			out << (i ? " | " : " ") << longest_chain[i];
+		}
+		out << std::endl;
+	}
+	out.flags(flags);
+	out.precision(precision);
+}
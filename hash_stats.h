@@ -0,0 +1,69 @@
+/*******************************************************************************
+  Title          : hash_stats.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the HashStats struct
+  Purpose        : To find out how well the hash tables of the subway system
+									 spread their entries
+  Usage          : Call statistics on a HashTable object and display the
+									 result
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __HASH_STATS_H__
+#define __HASH_STATS_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+
+		The HashStats struct describes how the entries of an open-addressing 
+		hash table are laid out: how full the table is, how many probes finding 
+		each entry takes, how many probes it takes to find out that a name is not
+		in the table, and how many entries share each home slot (the slot their
+		hash picks). A good hash function keeps the probes per entry close to 1
+		and the chains of entries that share a home slot short.
+
+*******************************************************************************/
+
+struct HashStats {
+	//	Number of slots, active entries and deleted entries of the table
+	unsigned int capacity;
+	unsigned int entries;
+	unsigned int deleted;
+
+	//	probes[k] is the number of entries that are found with k + 1 probes
+	std::vector<unsigned int> probes;
+
+	//	chains[k] is the number of home slots that k + 1 entries hash to
+	std::vector<unsigned int> chains;
+
+	//	Total number of probes that looking up a missing name takes, over a
+	//	lookup starting at every slot of the table
+	unsigned long miss_probes;
+
+	//	The names of the entries in the longest chain
+	std::vector<std::string> longest_chain;
+
+	//	Creates a HashStats object for an empty table of capacity slots
+	explicit HashStats(unsigned int capacity = 0);
+
+	//	Returns the number of entries per slot
+	double load_factor() const;
+
+	//	Returns the mean number of probes that finding an entry takes
+	double mean_probes() const;
+
+	//	Returns the mean number of probes that looking up a missing name takes
+	double mean_miss_probes() const;
+
+	//	Displays the statistics of the table named table
+	void display(std::ostream& out, const std::string& table) const;
+};
+
+#endif
+
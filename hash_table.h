@@ -0,0 +1,386 @@
+/*******************************************************************************
+  Title          : hash_table.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface and implementation file for the HashTable
+									 class template
+  Purpose        : To store named objects, such as stations and lines, in an
+									 open-addressing hash table that grows with its contents
+  Usage          : Instantiate HashTable with the type of the stored objects
+									 and a Key struct that names, hashes and compares them
+  Build with     : No building. This is a templated class
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __HASH_TABLE_H__
+#define __HASH_TABLE_H__
+
+#include <stdint.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "hash_entry.cpp"
+#include "hash_stats.h"
+
+/*******************************************************************************
+
+		The HashTable class template is an open-addressing hash table of objects
+		of type T that are looked up by name. Key must provide three static
+		functions: Key::name(object) returns an object's name, Key::hash(name)
+		returns a 64-bit hash of a name, and Key::equal(stored, name) returns
+		true if stored, the name of an object in the table, matches name.
+
+		The capacity of the table is always a power of two, and collisions are
+		resolved by probing the slots h, h + 1, h + 3, h + 6, ... (adding 1, 2,
+		3, ... in turn), which visits every slot of a table whose capacity is a
+		power of two, so an insertion always finds a free slot however full the
+		table is allowed to get. The table keeps the number of active entries
+		and of entries marked DELETED by remove (tombstones) at or below its
+		maximum load factor times its capacity. When an insertion would go over
+		it, the table is rehashed, which drops the tombstones: at the same
+		capacity if the active entries use at most half of the allowed load,
+		and at twice the capacity, or more, otherwise. reserve grows the table
+		ahead of a known number of insertions so that it is rehashed only once.
+
+		Removing an object moves no other, but an insertion or a reserve that
+		rehashes the table moves every object in it, so pointers and references
+		to objects in the table are only valid until the next rehash, which 
+		rehashes() counts. The const methods can be called by any number of 
+		threads at the same time.
+
+*******************************************************************************/
+
+template <class T, class Key>
+class HashTable {
+ public:
+	//	Creates an empty HashTable object with at least capacity slots, which
+	//	grows when more than max_load_factor of its slots would be used
+	explicit HashTable(unsigned int capacity = 16,
+										 double max_load_factor = kDefaultLoadFactor);
+
+	//	Inserts object unless an object of the same name is in the table.
+	//	Returns true if object was inserted
+	bool insert(const T& object);
+
+	//	Removes the object named name, leaving a tombstone in its slot. Returns
+	//	true if there was such an object
+	bool remove(const std::string& name);
+
+	//	Removes every object and every tombstone, keeping the capacity
+	void clear();
+
+	//	Returns the object named name, or NULL if there is none
+	const T* find(const std::string& name) const;
+
+	//	Grows the table, if needed, so that entries objects fit without
+	//	rehashing
+	void reserve(unsigned int entries);
+
+	//	Sets the fraction of slots, from 0.1 to 0.95, that active entries and
+	//	tombstones may use before the table is rehashed
+	void set_max_load_factor(double max_load_factor);
+
+	//	Returns the fraction of slots that may be used before rehashing
+	double max_load_factor() const;
+
+	//	Returns the number of objects in the table
+	unsigned int size() const;
+
+	//	Returns the number of slots in the table
+	unsigned int capacity() const;
+
+	//	Returns the number of tombstones in the table
+	unsigned int deleted() const;
+
+	//	Returns the number of times the table has been rehashed, which moves
+	//	every object in it
+	unsigned int rehashes() const;
+
+	//	Calls visit(object) for every object in the table, in the order of
+	//	their slots. visit may modify an object but not its name
+	template <class Visit>
+	void for_each(Visit visit);
+
+	//	Calls visit(object) for every object in the table, in the order of
+	//	their slots
+	template <class Visit>
+	void for_each(Visit visit) const;
+
+	//	Returns how the objects are spread over the slots of the table
+	HashStats statistics() const;
+
+	//	The default maximum load factor, at which the tables of this project
+	//	have always been rehashed
+	static constexpr double kDefaultLoadFactor = 0.5;
+
+ private:
+	//	The slots of the table, whose number is a power of two
+	std::vector< HashEntry<T> > table_;
+
+	//	Number of active entries and of tombstones in table_
+	unsigned int size_;
+	unsigned int deleted_;
+
+	//	Number of times table_ has been rehashed
+	unsigned int rehashes_;
+
+	//	Fraction of the slots that active entries and tombstones may use
+	double max_load_factor_;
+
+	//	Returns the slot of the object named name, whose hash is hash, or the
+	//	first empty slot of its probe sequence if there is no such object. If
+	//	tombstone is not NULL, it is set to the first tombstone of the probe
+	//	sequence before that slot, or to the capacity if there is none
+	unsigned int find_pos(const std::string& name, uint64_t hash,
+												unsigned int* tombstone) const;
+
+	//	Returns the number of probes from the slot home to the slot pos
+	unsigned int probes(unsigned int home, unsigned int pos) const;
+
+	//	Returns the smallest capacity, a power of two no less than 8, at which
+	//	entries active entries do not go over max_load_factor_
+	unsigned int capacity_for(unsigned int entries) const;
+
+	//	Moves every active entry into a table of capacity slots, dropping the
+	//	tombstones
+	void rehash(unsigned int capacity);
+};
+
+template <class T, class Key>
+constexpr double HashTable<T, Key>::kDefaultLoadFactor;
+
+template <class T, class Key>
+HashTable<T, Key>::HashTable(unsigned int capacity, double max_load_factor) :
+    table_(), size_(0), deleted_(0), rehashes_(0),
+    max_load_factor_(kDefaultLoadFactor)
+{
+	set_max_load_factor(max_load_factor);
+	unsigned int slots = 8;
+	while (slots < capacity) {
+		slots *= 2;
+	}
+	table_.resize(slots);
+}
+
+template <class T, class Key>
+bool HashTable<T, Key>::insert(const T& object) {
+	const std::string& name = Key::name(object);
+	if (size_ + deleted_ + 1 > max_load_factor_ * table_.size()) {
+		if (2 * (size_ + 1) <= max_load_factor_ * table_.size()) {
+			rehash(table_.size());
+		} else {
+			rehash(std::max((unsigned int)table_.size() * 2,
+											capacity_for(size_ + 1)));
+		}
+	}
+	unsigned int tombstone;
+	unsigned int pos = find_pos(name, Key::hash(name), &tombstone);
+	if (table_[pos].active()) {
+		return false;
+	}
+	if (tombstone < table_.size()) {
+		pos = tombstone;
+		--deleted_;
+	}
+	table_[pos] = HashEntry<T>(object, ACTIVE);
+	++size_;
+	return true;
+}
+
+template <class T, class Key>
+bool HashTable<T, Key>::remove(const std::string& name) {
+	unsigned int pos = find_pos(name, Key::hash(name), NULL);
+	if (!table_[pos].active()) {
+		return false;
+	}
+	table_[pos] = HashEntry<T>(T(), DELETED);
+	--size_;
+	++deleted_;
+	return true;
+}
+
+template <class T, class Key>
+void HashTable<T, Key>::clear() {
+	for (auto& entry : table_) {
+		entry = HashEntry<T>();
+	}
+	size_ = 0;
+	deleted_ = 0;
+}
+
+template <class T, class Key>
+const T* HashTable<T, Key>::find(const std::string& name) const {
+	unsigned int pos = find_pos(name, Key::hash(name), NULL);
+	return table_[pos].active() ? &table_[pos].data : NULL;
+}
+
+template <class T, class Key>
+void HashTable<T, Key>::reserve(unsigned int entries) {
+	unsigned int capacity = capacity_for(entries);
+	if (capacity > table_.size()) {
+		rehash(capacity);
+	}
+}
+
+template <class T, class Key>
+void HashTable<T, Key>::set_max_load_factor(double max_load_factor) {
+	max_load_factor_ = std::min(std::max(max_load_factor, 0.1), 0.95);
+}
+
+template <class T, class Key>
+double HashTable<T, Key>::max_load_factor() const {
+	return max_load_factor_;
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::size() const {
+	return size_;
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::capacity() const {
+	return table_.size();
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::deleted() const {
+	return deleted_;
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::rehashes() const {
+	return rehashes_;
+}
+
+template <class T, class Key>
+template <class Visit>
+void HashTable<T, Key>::for_each(Visit visit) {
+	for (auto& entry : table_) {
+		if (entry.active()) {
+			visit(entry.data);
+		}
+	}
+}
+
+template <class T, class Key>
+template <class Visit>
+void HashTable<T, Key>::for_each(Visit visit) const {
+	for (auto& entry : table_) {
+		if (entry.active()) {
+			visit(entry.data);
+		}
+	}
+}
+
+template <class T, class Key>
+HashStats HashTable<T, Key>::statistics() const {
+	HashStats stats(table_.size());
+	stats.entries = size_;
+	stats.deleted = deleted_;
+	std::vector< std::vector<unsigned int> > homes(table_.size());
+	for (unsigned int i = 0; i < table_.size(); ++i) {
+		if (!table_[i].active()) {
+			continue;
+		}
+		unsigned int home = Key::hash(Key::name(table_[i].data)) &
+												(table_.size() - 1);
+		homes[home].push_back(i);
+		unsigned int count = probes(home, i);
+		if (stats.probes.size() < count) {
+			stats.probes.resize(count);
+		}
+		++stats.probes[count - 1];
+	}
+
+	unsigned int longest = table_.size();
+	for (unsigned int h = 0; h < table_.size(); ++h) {
+		//	a lookup of a missing name ends at the first empty slot
+		unsigned int pos = h, count = 1;
+		while (table_[pos].status != EMPTY) {
+			pos = (pos + count++) & (table_.size() - 1);
+		}
+		stats.miss_probes += count;
+		if (homes[h].empty()) {
+			continue;
+		}
+		if (stats.chains.size() < homes[h].size()) {
+			stats.chains.resize(homes[h].size());
+			longest = h;
+		}
+		++stats.chains[homes[h].size() - 1];
+	}
+	if (longest < table_.size()) {
+		for (auto& i : homes[longest]) {
+			stats.longest_chain.push_back(Key::name(table_[i].data));
+		}
+	}
+	return stats;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::find_pos(const std::string& name,
+																				 uint64_t hash,
+																				 unsigned int* tombstone) const {
+	unsigned int mask = table_.size() - 1;
+	unsigned int pos = hash & mask;
+	if (tombstone) {
+		*tombstone = table_.size();
+	}
+	for (unsigned int offset = 1; table_[pos].status != EMPTY; ++offset) {
+		if (table_[pos].active()) {
+			if (Key::equal(Key::name(table_[pos].data), name)) {
+				return pos;
+			}
+		} else if (tombstone && *tombstone == table_.size()) {
+			*tombstone = pos;
+		}
+		pos = (pos + offset) & mask;
+	}
+	return pos;
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::probes(unsigned int home,
+																			 unsigned int pos) const {
+	unsigned int count = 1;
+	while (home != pos) {
+		home = (home + count++) & (table_.size() - 1);
+	}
+	return count;
+}
+
+template <class T, class Key>
+unsigned int HashTable<T, Key>::capacity_for(unsigned int entries) const {
+	unsigned int capacity = 8;
+	while (entries > max_load_factor_ * capacity) {
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+template <class T, class Key>
+void HashTable<T, Key>::rehash(unsigned int capacity) {
+	std::vector< HashEntry<T> > old_table(capacity);
+	old_table.swap(table_);
+	++rehashes_;
+	size_ = 0;
+	deleted_ = 0;
+	for (auto& entry : old_table) {
+		if (entry.active()) {
+			const std::string& name = Key::name(entry.data);
+			table_[find_pos(name, Key::hash(name), NULL)] = std::move(entry);
+			++size_;
+		}
+	}
+}
+
+#endif
+
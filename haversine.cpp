@@ -6,7 +6,7 @@
   Purpose        : 
   Usage          : haversine latitude1 longitude1 latitude2 longitude2 in degrees
   Build with     : gcc -o haversine haversine.v -lm
-  Modifications  : 
+  Modifications  : October 19, 2026 - Added haversine_to_box
  
 *******************************************************************************/
 
@@ -36,3 +36,42 @@ double haversine(double lat1, double lon1, double lat2, double lon2)
     double b    = sin(dLon);
     return 2*RA * asin(sqrt(a*a + cos(lat1) * cos(lat2) * b*b));
 }
+
+double haversine_to_box(double lat, double lon, double min_lat, double min_lon,
+												double max_lat, double max_lon)
+{
+	//	the haversine formula with the latitude difference, the longitude 
+	//	difference and the cosine of the box's latitude each made as small as
+	//	they can be in the box, which can only make the distance smaller. The
+	//	longitude difference is taken the shorter way around the globe, since
+	//	the formula only grows with it up to 180 degrees
+	double nearest_lat = fmax(min_lat, fmin(lat, max_lat));
+	double columns = 0;
+	if (lon < min_lon || lon > max_lon) {
+		columns = fmin(fmod(fmod(min_lon - lon, 360) + 360, 360),
+									 fmod(fmod(lon - max_lon, 360) + 360, 360));
+		columns = fmin(columns, 180.0);
+	}
+	double a = sin(TO_RAD * (nearest_lat - lat) / 2);
+	double b = sin(TO_RAD * columns / 2);
+	double cosine = fmin(cos(TO_RAD * min_lat), cos(TO_RAD * max_lat));
+	double h = a * a + cos(TO_RAD * lat) * cosine * b * b;
+	return 2 * RA * asin(sqrt(fmin(h, 1.0)));
+}
+
+void haversine_box(double lat, double lon, double radius, double& min_lat,
+									 double& min_lon, double& max_lat, double& max_lon)
+{
+	//	a point within radius is at most that far north or south, and its 
+	//	distance is at least what the longitude difference alone makes at the
+	//	smallest cosine of latitude it can have
+	const double kMargin = 1e-9;
+	double rows = radius / (RA * TO_RAD) + kMargin;
+	double c = cos(TO_RAD * lat) * cos(TO_RAD * fmin(90.0, fabs(lat) + rows));
+	double s = c > 0 ? sin(radius / (2 * RA)) / sqrt(c) : 1;
+	double columns = s < 1 ? 2 * asin(s) / TO_RAD + kMargin : 360;
+	min_lat = lat - rows;
+	max_lat = lat + rows;
+	min_lon = lon - columns;
+	max_lon = lon + columns;
+}
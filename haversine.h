@@ -6,7 +6,7 @@
   Purpose        : 
   Usage          : haversine latitude1 longitude1 latitude2 longitude2 in degrees
   Build with     : gcc -o haversine haversine.v -lm
-  Modifications  : 
+  Modifications  : October 19, 2026 - Added haversine_to_box
  
 *******************************************************************************/
 #ifndef __HAVERSINE_H__
@@ -24,4 +24,19 @@ double dist(double th1, double ph1, double th2, double ph2);
 
 double haversine(double lat1, double lon1, double lat2, double lon2);
 
+//	Returns a lower bound on the haversine distance from the point at lat and
+//	lon to any point in the box with the given corners, which is 0 if the 
+//	point is inside the box. The bound can be larger than the true distance by
+//	rounding error only, so callers that must not lose ties subtract a small
+//	margin from it
+double haversine_to_box(double lat, double lon, double min_lat, double min_lon,
+												double max_lat, double max_lon);
+
+//	Sets the box with the given corners to one that holds every point within
+//	radius kilometers of the point at lat and lon, with a small margin so 
+//	that rounding never leaves out a point on its edge. The box covers every
+//	longitude if the point is too close to a pole for a narrower one
+void haversine_box(double lat, double lon, double radius, double& min_lat,
+									 double& min_lon, double& max_lat, double& max_lon);
+
 #endif
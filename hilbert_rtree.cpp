@@ -0,0 +1,463 @@
+/*******************************************************************************
+  Title          : hilbert_rtree.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the HilbertRTree class
+  Purpose        : To find every point, such as a station or an entrance, that
+									 lies inside a box or a polygon
+  Usage          : Build a HilbertRTree object from the coordinates of a list
+									 of points and call search with a box or a polygon; the
+									 points are returned as positions in that list
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "hilbert_rtree.h"
+#include "haversine.h"
+#include <algorithm>
+#include <functional>
+
+const unsigned int HilbertRTree::kNoPoint;
+
+HilbertRTree::HilbertRTree() : points_(), latitudes_(), longitudes_(), 
+    slots_(), count_(0), boxes_(), room_(), levels_(1, 0)
+{
+}
+
+HilbertRTree::~HilbertRTree()
+{
+}
+
+void HilbertRTree::build(const std::vector<double>& latitudes,
+												 const std::vector<double>& longitudes) {
+	std::vector<unsigned int> positions(latitudes.size());
+	for (unsigned int i = 0; i < positions.size(); ++i) {
+		positions[i] = i;
+	}
+	pack(positions, latitudes, longitudes, kFanout);
+}
+
+void HilbertRTree::search(double min_latitude, double min_longitude,
+													double max_latitude, double max_longitude,
+													std::vector<unsigned int>& found) const {
+	found.clear();
+	if (count_ == 0) {
+		return;
+	}
+	Box box = { min_latitude, min_longitude, max_latitude, max_longitude };
+	search(levels_.size() - 2, 0, box, NULL, found);
+	std::sort(found.begin(), found.end());
+}
+
+void HilbertRTree::search(const std::vector<Vertex>& polygon,
+													std::vector<unsigned int>& found) const {
+	found.clear();
+	if (count_ == 0 || polygon.size() < 3) {
+		return;
+	}
+	Box box = { polygon[0].first, polygon[0].second, polygon[0].first,
+							polygon[0].second };
+	for (auto& v : polygon) {
+		box.min_latitude = std::min(box.min_latitude, v.first);
+		box.min_longitude = std::min(box.min_longitude, v.second);
+		box.max_latitude = std::max(box.max_latitude, v.first);
+		box.max_longitude = std::max(box.max_longitude, v.second);
+	}
+	search(levels_.size() - 2, 0, box, &polygon, found);
+	std::sort(found.begin(), found.end());
+}
+
+void HilbertRTree::nearest(double latitude, double longitude,
+													 QueryScratch& scratch) const {
+	nearest(latitude, longitude, 0, nullptr, scratch);
+}
+
+void HilbertRTree::nearest(double latitude, double longitude, double reach,
+									const std::function<double(unsigned int, double)>& visit,
+									QueryScratch& scratch) const {
+	std::vector< std::pair<double, unsigned int> >& queue = scratch.queue;
+	std::greater< std::pair<double, unsigned int> > later;
+	scratch.indices.clear();
+	scratch.distance = HUGE_VAL;
+	scratch.runner_up = HUGE_VAL;
+	queue.clear();
+	if (count_ == 0) {
+		return;
+	}
+
+	//	the queue holds boxes by their index in boxes_, closest first, each 
+	//	brought closer by reach; the small margin keeps rounding from skipping
+	//	a tie
+	double wanted = visit ? HUGE_VAL : -HUGE_VAL;
+	queue.push_back(std::make_pair(-reach, (unsigned int)boxes_.size() - 1));
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), later);
+		std::pair<double, unsigned int> next = queue.back();
+		queue.pop_back();
+		if (next.first > std::max(scratch.runner_up, wanted)) {
+			break;
+		}
+		++scratch.probes;
+		unsigned int level = 0;
+		while (next.second >= levels_[level + 1]) {
+			++level;
+		}
+		unsigned int index = next.second - levels_[level];
+
+		if (level == 0) {
+			for (unsigned int i = index * kFanout; 
+					 i < std::min((index + 1) * kFanout, (unsigned int)points_.size());
+					 ++i) {
+				if (points_[i] == kNoPoint) {
+					continue;
+				}
+				double distance = haversine(latitude, longitude, latitudes_[i],
+																		longitudes_[i]);
+				if (distance < scratch.distance) {
+					scratch.runner_up = scratch.distance;
+					scratch.distance = distance;
+					scratch.indices.clear();
+					scratch.indices.push_back(points_[i]);
+				} else if (distance == scratch.distance) {
+					scratch.indices.push_back(points_[i]);
+				} else if (distance < scratch.runner_up) {
+					scratch.runner_up = distance;
+				}
+				if (visit) {
+					wanted = visit(points_[i], distance);
+				}
+			}
+			continue;
+		}
+		for (unsigned int c = levels_[level - 1] + index * kFanout;
+				 c < std::min(levels_[level - 1] + (index + 1) * kFanout, 
+											levels_[level]); ++c) {
+			const Box& box = boxes_[c];
+			if (box.min_latitude > box.max_latitude) {
+				continue;
+			}
+			double bound = haversine_to_box(latitude, longitude, box.min_latitude,
+																			box.min_longitude, box.max_latitude,
+																			box.max_longitude) - 1e-9 - reach;
+			if (bound <= std::max(scratch.runner_up, wanted)) {
+				queue.push_back(std::make_pair(bound, c));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+		}
+	}
+	std::sort(scratch.indices.begin(), scratch.indices.end());
+}
+
+bool HilbertRTree::insert(unsigned int position, double latitude,
+													double longitude) {
+	if (boxes_.empty() || room_.back() == 0) {
+		std::vector<unsigned int> positions;
+		std::vector<double> latitudes, longitudes;
+		for (unsigned int i = 0; i < points_.size(); ++i) {
+			if (points_[i] != kNoPoint) {
+				positions.push_back(points_[i]);
+				latitudes.push_back(latitudes_[i]);
+				longitudes.push_back(longitudes_[i]);
+			}
+		}
+		positions.push_back(position);
+		latitudes.push_back(latitude);
+		longitudes.push_back(longitude);
+		pack(positions, latitudes, longitudes, kFill);
+		return true;
+	}
+
+	//	go down through the child with room whose box grows the least, 
+	//	measured by how much longer its sides get; an empty box grows the most
+	unsigned int index = 0;
+	for (unsigned int level = levels_.size() - 2; level > 0; --level) {
+		unsigned int first = levels_[level - 1] + index * kFanout;
+		unsigned int last = std::min(first + kFanout, levels_[level]);
+		unsigned int best = last;
+		double least = 0;
+		for (unsigned int c = first; c < last; ++c) {
+			if (room_[c] == 0) {
+				continue;
+			}
+			const Box& box = boxes_[c];
+			double growth = HUGE_VAL;
+			if (box.min_latitude <= box.max_latitude) {
+				growth = std::max(box.max_latitude, latitude) - 
+								 std::min(box.min_latitude, latitude) - 
+								 (box.max_latitude - box.min_latitude) +
+								 std::max(box.max_longitude, longitude) - 
+								 std::min(box.min_longitude, longitude) - 
+								 (box.max_longitude - box.min_longitude);
+			}
+			if (best == last || growth < least) {
+				best = c;
+				least = growth;
+			}
+		}
+		index = best - levels_[level - 1];
+	}
+	unsigned int slot = index * kFanout;
+	while (points_[slot] != kNoPoint) {
+		++slot;
+	}
+	points_[slot] = position;
+	latitudes_[slot] = latitude;
+	longitudes_[slot] = longitude;
+	if (slots_.size() <= position) {
+		slots_.resize(position + 1, kNoPoint);
+	}
+	slots_[position] = slot;
+	++count_;
+	refresh_path(slot);
+	return false;
+}
+
+void HilbertRTree::remove(unsigned int position) {
+	if (position >= slots_.size() || slots_[position] == kNoPoint) {
+		return;
+	}
+	unsigned int slot = slots_[position];
+	points_[slot] = kNoPoint;
+	slots_[position] = kNoPoint;
+	--count_;
+	refresh_path(slot);
+}
+
+void HilbertRTree::move(unsigned int from, unsigned int to) {
+	unsigned int slot = slots_[from];
+	if (slots_.size() <= to) {
+		slots_.resize(to + 1, kNoPoint);
+	}
+	points_[slot] = to;
+	slots_[to] = slot;
+	slots_[from] = kNoPoint;
+}
+
+void HilbertRTree::renumber() {
+	slots_.assign(count_, kNoPoint);
+	unsigned int position = 0;
+	for (unsigned int slot = 0; slot < points_.size(); ++slot) {
+		if (points_[slot] != kNoPoint) {
+			points_[slot] = position;
+			slots_[position++] = slot;
+		}
+	}
+}
+
+const std::vector<unsigned int>& HilbertRTree::order() const {
+	return points_;
+}
+
+unsigned int HilbertRTree::size() const {
+	return count_;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void HilbertRTree::pack(const std::vector<unsigned int>& positions,
+												const std::vector<double>& latitudes,
+												const std::vector<double>& longitudes,
+												unsigned int fill) {
+	unsigned int n = positions.size();
+	points_.clear();
+	latitudes_.clear();
+	longitudes_.clear();
+	slots_.clear();
+	count_ = n;
+	boxes_.clear();
+	room_.clear();
+	levels_.assign(1, 0);
+	if (n == 0) {
+		return;
+	}
+
+	//	number the cells of a 65536 by 65536 grid over the box of all points
+	//	along the Hilbert curve, and sort the points by the number of their cell
+	Box all = { latitudes[0], longitudes[0], latitudes[0], longitudes[0] };
+	for (unsigned int i = 1; i < n; ++i) {
+		all.min_latitude = std::min(all.min_latitude, latitudes[i]);
+		all.min_longitude = std::min(all.min_longitude, longitudes[i]);
+		all.max_latitude = std::max(all.max_latitude, latitudes[i]);
+		all.max_longitude = std::max(all.max_longitude, longitudes[i]);
+	}
+	double height = all.max_latitude - all.min_latitude;
+	double width = all.max_longitude - all.min_longitude;
+	std::vector< std::pair<uint32_t, unsigned int> > order(n);
+	for (unsigned int i = 0; i < n; ++i) {
+		uint32_t x = (width > 0) 
+			? (uint32_t)((longitudes[i] - all.min_longitude) / width * 65535) : 0;
+		uint32_t y = (height > 0)
+			? (uint32_t)((latitudes[i] - all.min_latitude) / height * 65535) : 0;
+		order[i] = std::make_pair(hilbert_distance(x, y), i);
+	}
+	std::sort(order.begin(), order.end());
+
+	//	every leaf but a full last one ends with kFanout - fill empty slots
+	unsigned int slots = (fill == kFanout) ? n : (n + fill - 1) / fill * kFanout;
+	points_.assign(slots, kNoPoint);
+	latitudes_.assign(slots, 0);
+	longitudes_.assign(slots, 0);
+	for (unsigned int k = 0; k < n; ++k) {
+		unsigned int slot = k / fill * kFanout + k % fill;
+		unsigned int i = order[k].second;
+		points_[slot] = positions[i];
+		latitudes_[slot] = latitudes[i];
+		longitudes_[slot] = longitudes[i];
+		if (slots_.size() <= positions[i]) {
+			slots_.resize(positions[i] + 1, kNoPoint);
+		}
+		slots_[positions[i]] = slot;
+	}
+
+	//	the leaves bound kFanout consecutive slots, and each level above bounds
+	//	kFanout consecutive boxes of the level below
+	levels_.push_back((slots + kFanout - 1) / kFanout);
+	while (levels_.back() - levels_[levels_.size() - 2] > 1) {
+		unsigned int boxes = levels_.back() - levels_[levels_.size() - 2];
+		levels_.push_back(levels_.back() + (boxes + kFanout - 1) / kFanout);
+	}
+	boxes_.resize(levels_.back());
+	room_.resize(levels_.back());
+	for (unsigned int level = 0; level + 1 < levels_.size(); ++level) {
+		for (unsigned int i = 0; i < levels_[level + 1] - levels_[level]; ++i) {
+			refresh(level, i);
+		}
+	}
+}
+
+void HilbertRTree::refresh(unsigned int level, unsigned int index) {
+	Box& box = boxes_[levels_[level] + index];
+	unsigned int& room = room_[levels_[level] + index];
+	box.min_latitude = box.min_longitude = HUGE_VAL;
+	box.max_latitude = box.max_longitude = -HUGE_VAL;
+	room = 0;
+	if (level == 0) {
+		for (unsigned int i = index * kFanout; 
+				 i < std::min((index + 1) * kFanout, (unsigned int)points_.size());
+				 ++i) {
+			if (points_[i] == kNoPoint) {
+				++room;
+				continue;
+			}
+			box.min_latitude = std::min(box.min_latitude, latitudes_[i]);
+			box.min_longitude = std::min(box.min_longitude, longitudes_[i]);
+			box.max_latitude = std::max(box.max_latitude, latitudes_[i]);
+			box.max_longitude = std::max(box.max_longitude, longitudes_[i]);
+		}
+		return;
+	}
+	for (unsigned int c = levels_[level - 1] + index * kFanout;
+			 c < std::min(levels_[level - 1] + (index + 1) * kFanout, 
+										levels_[level]); ++c) {
+		box.min_latitude = std::min(box.min_latitude, boxes_[c].min_latitude);
+		box.min_longitude = std::min(box.min_longitude, boxes_[c].min_longitude);
+		box.max_latitude = std::max(box.max_latitude, boxes_[c].max_latitude);
+		box.max_longitude = std::max(box.max_longitude, boxes_[c].max_longitude);
+		room += room_[c];
+	}
+}
+
+void HilbertRTree::refresh_path(unsigned int slot) {
+	unsigned int index = slot / kFanout;
+	for (unsigned int level = 0; level + 1 < levels_.size(); ++level) {
+		refresh(level, index);
+		index /= kFanout;
+	}
+}
+
+void HilbertRTree::search(unsigned int level, unsigned int index, 
+													const Box& box, const std::vector<Vertex>* polygon,
+													std::vector<unsigned int>& found) const {
+	const Box& node = boxes_[levels_[level] + index];
+	if (node.max_latitude < box.min_latitude || 
+			node.min_latitude > box.max_latitude ||
+			node.max_longitude < box.min_longitude || 
+			node.min_longitude > box.max_longitude) {
+		return;
+	}
+
+	//	the points under a box of level k are a range of kFanout^(k + 1) points
+	unsigned int span = kFanout;
+	for (unsigned int k = 0; k < level; ++k) {
+		span *= kFanout;
+	}
+	unsigned int first = index * span;
+	unsigned int last = std::min(first + span, (unsigned int)points_.size());
+	if (!polygon && node.min_latitude >= box.min_latitude &&
+			node.max_latitude <= box.max_latitude &&
+			node.min_longitude >= box.min_longitude &&
+			node.max_longitude <= box.max_longitude) {
+		if (room_[levels_[level] + index] == 0) {
+			found.insert(found.end(), points_.begin() + first, 
+									 points_.begin() + last);
+			return;
+		}
+		for (unsigned int i = first; i < last; ++i) {
+			if (points_[i] != kNoPoint) {
+				found.push_back(points_[i]);
+			}
+		}
+		return;
+	}
+
+	if (level == 0) {
+		for (unsigned int i = first; i < last; ++i) {
+			if (points_[i] != kNoPoint && latitudes_[i] >= box.min_latitude && 
+					latitudes_[i] <= box.max_latitude &&
+					longitudes_[i] >= box.min_longitude &&
+					longitudes_[i] <= box.max_longitude &&
+					(!polygon || inside(*polygon, latitudes_[i], longitudes_[i]))) {
+				found.push_back(points_[i]);
+			}
+		}
+		return;
+	}
+	unsigned int children = levels_[level] - levels_[level - 1];
+	for (unsigned int c = index * kFanout; 
+			 c < std::min((index + 1) * kFanout, children); ++c) {
+		search(level - 1, c, box, polygon, found);
+	}
+}
+
+uint32_t HilbertRTree::hilbert_distance(uint32_t x, uint32_t y) {
+	const uint32_t n = 65536;
+	uint32_t distance = 0;
+	for (uint32_t s = n / 2; s > 0; s /= 2) {
+		uint32_t rx = (x & s) ? 1 : 0;
+		uint32_t ry = (y & s) ? 1 : 0;
+		distance += s * s * ((3 * rx) ^ ry);
+		//	rotate the quadrant so that the curve inside it starts and ends in 
+		//	the right corners
+		if (ry == 0) {
+			if (rx == 1) {
+				x = n - 1 - x;
+				y = n - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return distance;
+}
+
+bool HilbertRTree::inside(const std::vector<Vertex>& polygon, double latitude,
+													double longitude) {
+	//	count the edges that a ray from the point toward increasing longitude 
+	//	crosses; the point is inside if the count is odd
+	bool crossed = false;
+	for (unsigned int i = 0, j = polygon.size() - 1; i < polygon.size(); 
+			 j = i++) {
+		const Vertex& a = polygon[i];
+		const Vertex& b = polygon[j];
+		if ((a.first > latitude) != (b.first > latitude) &&
+				longitude < (b.second - a.second) * (latitude - a.first) / 
+										(b.first - a.first) + a.second) {
+			crossed = !crossed;
+		}
+	}
+	return crossed;
+}
@@ -0,0 +1,211 @@
+/*******************************************************************************
+  Title          : hilbert_rtree.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the HilbertRTree class
+  Purpose        : To find every point, such as a station or an entrance, that
+									 lies inside a box or a polygon
+  Usage          : Build a HilbertRTree object from the coordinates of a list
+									 of points and call search with a box or a polygon; the
+									 points are returned as positions in that list
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __HILBERT_RTREE_H__
+#define __HILBERT_RTREE_H__
+
+#include <stdint.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "query_scratch.h"
+
+/*******************************************************************************
+
+		The HilbertRTree class is an R-tree of points that is bulk loaded. The
+		points are sorted along a Hilbert curve drawn over the box that holds 
+		all of them, which keeps points that are close on the map close in the
+		sorted order, and every kFanout consecutive points become a leaf of the
+		tree. Each level above bounds kFanout consecutive boxes of the
+		level below. All the boxes are kept in one vector, level by level, and the
+		sorted coordinates in two more, so the tree has no pointers and a leaf's
+		points are next to each other in memory.
+
+		Because the tree is packed, the points under any box are a single range of
+		the sorted order. A search that reaches a box that lies entirely inside 
+		the query box takes that whole range without looking at its points, so a
+		box query costs about as much as the boundary of the box, not its area.
+		Polygons are searched with their bounding box first, and only the points
+		inside it are tested against the polygon. Coordinates are latitudes and
+		longitudes in degrees, and a polygon's edges are straight lines between 
+		its vertices on a map of them, which is accurate for polygons the size of
+		a borough.
+
+		The tree also answers nearest point queries, best first: boxes are
+		visited in the order of their least possible haversine distance to the
+		query point, and the search stops once that distance is farther than 
+		the second closest distance found so far. Anything that keeps a list of
+		points in the order of order() has the points of every leaf next to each
+		other, so a search reads a few contiguous runs of the list. A built 
+		HilbertRTree is never modified by a search, so any number of threads can
+		search it at the same time, as long as each thread uses its own 
+		QueryScratch object.
+
+		Points can also be inserted and removed one at a time without packing
+		the tree again. A removed point leaves its slot empty, and the boxes on
+		the way from its leaf to the root shrink to what is left under them. An
+		inserted point goes down from the root into the child with an empty 
+		slot under it whose box grows the least, as in any R-tree, and the 
+		boxes on its way up grow to hold it. Each box counts the empty slots 
+		under it, so finding one never looks outside that path. Only when no 
+		slot is left is the tree packed again, with each leaf a quarter empty,
+		so the points inserted before that pay for it.
+
+*******************************************************************************/
+
+class HilbertRTree {
+ public:
+	//	A vertex of a polygon, as a latitude and longitude
+	typedef std::pair<double, double> Vertex;
+
+	//	Creates an empty HilbertRTree object
+	HilbertRTree();
+
+	//	Destroys HilbertRTree object
+	~HilbertRTree();
+
+	//	Builds the tree of the points at the given latitudes and longitudes,
+	//	replacing the previous tree, if any. Point i is at latitudes[i] and 
+	//	longitudes[i]
+	void build(const std::vector<double>& latitudes,
+						 const std::vector<double>& longitudes);
+
+	//	Sets found to the positions of the points inside the box with the given 
+	//	corners, edges included, in increasing order
+	void search(double min_latitude, double min_longitude, double max_latitude,
+							double max_longitude, std::vector<unsigned int>& found) const;
+
+	//	Sets found to the positions of the points inside polygon, whose vertices
+	//	are in order around it, in increasing order. The polygon may be concave 
+	//	but its edges must not cross. A point on an edge may or may not be found
+	void search(const std::vector<Vertex>& polygon,
+							std::vector<unsigned int>& found) const;
+
+	//	Sets scratch.indices to the positions of the points that are tied for
+	//	being the closest to the given latitude and longitude, in increasing 
+	//	order, scratch.distance to their haversine distance in kilometers and
+	//	scratch.runner_up to the distance of the closest point that is farther
+	//	away. The distances are exactly the ones haversine(latitude, longitude,
+	//	...) gives, so the answer is the same as comparing every point. Adds 
+	//	the number of boxes visited to scratch.probes
+	void nearest(double latitude, double longitude, 
+							 QueryScratch& scratch) const;
+
+	//	Finds the closest points the same way, and also calls visit with the 
+	//	position and distance of every point that may be within reach of 
+	//	something that is still being searched for. visit returns how far away
+	//	that something may still be, and the search keeps going until no box
+	//	left can hold a point within reach of that distance or of the runner 
+	//	up. This lets the closest of some other things that are each within
+	//	reach of a point, such as the entrances of a station, be found in the
+	//	same search
+	void nearest(double latitude, double longitude, double reach,
+							 const std::function<double(unsigned int, double)>& visit,
+							 QueryScratch& scratch) const;
+
+	//	Adds a point at the given latitude and longitude with the given 
+	//	position, which must not hold a point. Returns true if the tree had to
+	//	be packed again to make room for it, which changes order()
+	bool insert(unsigned int position, double latitude, double longitude);
+
+	//	Removes the point with the given position, if there is one
+	void remove(unsigned int position);
+
+	//	Gives the point with position from the position to, which must not 
+	//	hold a point
+	void move(unsigned int from, unsigned int to);
+
+	//	Gives the points the positions 0, 1, 2, ... in the order of order(), 
+	//	which is how a list kept in that order is numbered once its empty slots
+	//	are taken out of it
+	void renumber();
+
+	//	Returns the positions of the points in the order of the Hilbert curve,
+	//	with kNoPoint in the slots that insert and remove have left empty
+	const std::vector<unsigned int>& order() const;
+
+	//	Returns the number of points
+	unsigned int size() const;
+
+	//	The position in order() of an empty slot
+	static const unsigned int kNoPoint = 0xffffffff;
+
+ private:
+	//	A rectangle of latitudes and longitudes
+	struct Box {
+		double min_latitude;
+		double min_longitude;
+		double max_latitude;
+		double max_longitude;
+	};
+
+	//	Number of points in a leaf, and of boxes under each box above the leaves
+	static const unsigned int kFanout = 16;
+
+	//	Number of points in each leaf when insert packs the tree again
+	static const unsigned int kFill = 12;
+
+	//	The position of each point in the list the tree was built from, and its
+	//	coordinates, all in the order of the Hilbert curve. These are the slots
+	//	of the leaves, and an empty slot holds kNoPoint
+	std::vector<unsigned int> points_;
+	std::vector<double> latitudes_;
+	std::vector<double> longitudes_;
+
+	//	The slot of each position, or kNoPoint for a position without a point,
+	//	and the number of points
+	std::vector<unsigned int> slots_;
+	unsigned int count_;
+
+	//	The boxes of every level of the tree, starting with the leaves, and the
+	//	number of empty slots under each. The boxes of level k are boxes_[
+	//	levels_[k]] to boxes_[levels_[k + 1] - 1], and the last box is the 
+	//	root. A box with nothing under it has its minimums above its maximums
+	std::vector<Box> boxes_;
+	std::vector<unsigned int> room_;
+	std::vector<unsigned int> levels_;
+
+	//	Builds the tree of the points with the given positions and coordinates,
+	//	putting fill points in each leaf and leaving the rest of its slots 
+	//	empty
+	void pack(const std::vector<unsigned int>& positions,
+						const std::vector<double>& latitudes,
+						const std::vector<double>& longitudes, unsigned int fill);
+
+	//	Sets the box at index of level, and its number of empty slots, from the
+	//	slots or boxes under it
+	void refresh(unsigned int level, unsigned int index);
+
+	//	Refreshes every box on the way from the leaf of slot to the root
+	void refresh_path(unsigned int slot);
+
+	//	Appends to found the positions of the points inside box that are under
+	//	the box at index of level. If polygon is not NULL, only the points that
+	//	are also inside polygon are appended
+	void search(unsigned int level, unsigned int index, const Box& box,
+							const std::vector<Vertex>* polygon,
+							std::vector<unsigned int>& found) const;
+
+	//	Returns the distance along a Hilbert curve that fills a square of 65536
+	//	by 65536 cells to the cell (x, y)
+	static uint32_t hilbert_distance(uint32_t x, uint32_t y);
+
+	//	Returns true if the point at latitude and longitude is inside polygon
+	static bool inside(const std::vector<Vertex>& polygon, double latitude,
+										 double longitude);
+};
+
+#endif
+
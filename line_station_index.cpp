@@ -0,0 +1,273 @@
+/*******************************************************************************
+  Title          : line_station_index.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the LineStationIndex class
+  Purpose        : To find the closest station to a point at which a given
+									 train line stops
+  Usage          : Build a LineStationIndex object from a SubwaySystem object's
+									 stations and call nearest with a latitude and longitude 
+									 point and a mask of the lines to search
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "line_station_index.h"
+#include "haversine.h"
+#include <algorithm>
+
+const unsigned int LineStationIndex::kNoNode;
+
+//	Number of stations for each empty node when the index is built again to
+//	make room
+static const unsigned int kSlack = 3;
+
+LineStationIndex::LineStationIndex() : nodes_()
+{
+}
+
+LineStationIndex::~LineStationIndex()
+{
+}
+
+void LineStationIndex::build(
+    const std::vector<const SubwayStation*>& stations) {
+	build(stations, 0);
+}
+
+void LineStationIndex::update(const std::vector<const SubwayStation*>& stations,
+															const std::vector<unsigned int>& changed) {
+	//	the old stations may be gone, so every one of them is taken out before
+	//	the masks above them are set again from the stations that are left
+	std::vector<unsigned int> emptied;
+	for (auto& p : changed) {
+		if (p < nodes_of_.size() && nodes_of_[p] != kNoNode) {
+			emptied.push_back(nodes_of_[p]);
+			nodes_[nodes_of_[p]].station = NULL;
+			nodes_of_[p] = kNoNode;
+		}
+	}
+	for (auto& node : emptied) {
+		refresh_path(node);
+	}
+	nodes_of_.resize(stations.size(), kNoNode);
+	for (auto& p : changed) {
+		if (p < stations.size() && !insert(p, stations[p])) {
+			build(stations, kSlack);
+			return;
+		}
+	}
+}
+
+void LineStationIndex::relink(
+    const std::vector<const SubwayStation*>& stations) {
+	for (auto& node : nodes_) {
+		if (node.station && node.order < stations.size()) {
+			node.station = stations[node.order];
+		}
+	}
+}
+
+void LineStationIndex::nearest(double latitude, double longitude,
+															 unsigned long lines,
+															 std::vector<const SubwayStation*>& found,
+															 std::vector<double>& distances) const {
+	found.assign(DEFAULT, NULL);
+	distances.assign(DEFAULT, HUGE_VAL);
+	unsigned int orders[DEFAULT];
+	search(0, nodes_.size(), true, latitude, longitude, lines, found, distances,
+				 orders);
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void LineStationIndex::build(const std::vector<const SubwayStation*>& stations,
+														 unsigned int slack) {
+	nodes_.clear();
+	nodes_of_.assign(stations.size(), kNoNode);
+	for (unsigned int i = 0; i < stations.size(); ++i) {
+		Node node;
+		node.station = stations[i];
+		stations[i]->get_coordinates(node.latitude, node.longitude);
+		node.order = i;
+		nodes_.push_back(node);
+		if (slack > 0 && i % slack == slack - 1) {
+			node.station = NULL;
+			nodes_.push_back(node);
+		}
+	}
+	build(0, nodes_.size(), true);
+	for (unsigned int i = 0; i < nodes_.size(); ++i) {
+		if (nodes_[i].station) {
+			nodes_of_[nodes_[i].order] = i;
+		}
+	}
+}
+
+void LineStationIndex::build(unsigned int first, unsigned int last, 
+														 bool by_latitude) {
+	if (first >= last) {
+		return;
+	}
+	unsigned int middle = (first + last) / 2;
+	std::nth_element(nodes_.begin() + first, nodes_.begin() + middle,
+									 nodes_.begin() + last,
+		[by_latitude](const Node& a, const Node& b) {
+			return by_latitude ? a.latitude < b.latitude 
+												 : a.longitude < b.longitude;
+		});
+	build(first, middle, !by_latitude);
+	build(middle + 1, last, !by_latitude);
+	refresh(first, last);
+}
+
+void LineStationIndex::refresh(unsigned int first, unsigned int last) {
+	unsigned int middle = (first + last) / 2;
+	Node& node = nodes_[middle];
+	node.min_latitude = node.min_longitude = HUGE_VAL;
+	node.max_latitude = node.max_longitude = -HUGE_VAL;
+	node.lines = 0UL;
+	node.room = 0;
+	if (node.station) {
+		node.min_latitude = node.max_latitude = node.latitude;
+		node.min_longitude = node.max_longitude = node.longitude;
+		node.lines = node.station->get_identifier();
+	} else {
+		node.room = 1;
+	}
+	unsigned int children[2] = { (first + middle) / 2, (middle + 1 + last) / 2 };
+	bool exists[2] = { first < middle, middle + 1 < last };
+	for (int i = 0; i < 2; ++i) {
+		if (exists[i]) {
+			const Node& child = nodes_[children[i]];
+			node.min_latitude = std::min(node.min_latitude, child.min_latitude);
+			node.max_latitude = std::max(node.max_latitude, child.max_latitude);
+			node.min_longitude = std::min(node.min_longitude, child.min_longitude);
+			node.max_longitude = std::max(node.max_longitude, child.max_longitude);
+			node.lines |= child.lines;
+			node.room += child.room;
+		}
+	}
+}
+
+void LineStationIndex::refresh_path(unsigned int node) {
+	std::vector< std::pair<unsigned int, unsigned int> > path;
+	unsigned int first = 0, last = nodes_.size();
+	while (true) {
+		path.push_back(std::make_pair(first, last));
+		unsigned int middle = (first + last) / 2;
+		if (node == middle) {
+			break;
+		}
+		if (node < middle) {
+			last = middle;
+		} else {
+			first = middle + 1;
+		}
+	}
+	for (unsigned int i = path.size(); i > 0; --i) {
+		refresh(path[i - 1].first, path[i - 1].second);
+	}
+}
+
+bool LineStationIndex::insert(unsigned int position, 
+															const SubwayStation* station) {
+	if (nodes_.empty() || nodes_[nodes_.size() / 2].room == 0) {
+		return false;
+	}
+	double latitude, longitude;
+	station->get_coordinates(latitude, longitude);
+
+	//	go down the side of each split that holds the station if it has room
+	unsigned int first = 0, last = nodes_.size();
+	bool by_latitude = true;
+	unsigned int middle = (first + last) / 2;
+	while (nodes_[middle].station) {
+		const Node& node = nodes_[middle];
+		bool before = by_latitude ? latitude < node.latitude 
+															: longitude < node.longitude;
+		bool room_before = first < middle && nodes_[(first + middle) / 2].room > 0;
+		bool room_after = middle + 1 < last && 
+											nodes_[(middle + 1 + last) / 2].room > 0;
+		if (room_before && (before || !room_after)) {
+			last = middle;
+		} else {
+			first = middle + 1;
+		}
+		by_latitude = !by_latitude;
+		middle = (first + last) / 2;
+	}
+	Node& node = nodes_[middle];
+	node.station = station;
+	node.latitude = latitude;
+	node.longitude = longitude;
+	node.order = position;
+	nodes_of_[position] = middle;
+	refresh_path(middle);
+	return true;
+}
+
+void LineStationIndex::search(unsigned int first, unsigned int last,
+															bool by_latitude, double latitude,
+															double longitude, unsigned long lines,
+															std::vector<const SubwayStation*>& found,
+															std::vector<double>& distances,
+															unsigned int orders[]) const {
+	if (first >= last) {
+		return;
+	}
+	unsigned int middle = (first + last) / 2;
+	const Node& node = nodes_[middle];
+	unsigned long wanted = lines & node.lines;
+	if (wanted == 0UL) {
+		return;
+	}
+
+	//	skip the subtree if every line wanted in it already has a closer 
+	//	station; the small margin keeps rounding from skipping a tie
+	double bound = haversine_to_box(latitude, longitude, node.min_latitude,
+																node.min_longitude, node.max_latitude,
+																node.max_longitude) - 1e-9;
+	bool needed = false;
+	for (int line = A; line < DEFAULT && !needed; ++line) {
+		needed = (wanted & (1UL << line)) && bound <= distances[line];
+	}
+	if (!needed) {
+		return;
+	}
+
+	unsigned long here = node.station ? wanted & node.station->get_identifier()
+																		: 0UL;
+	if (here != 0UL) {
+		double distance = haversine(latitude, longitude, node.latitude,
+																node.longitude);
+		for (int line = A; line < DEFAULT; ++line) {
+			if ((here & (1UL << line)) && (distance < distances[line] ||
+					(distance == distances[line] && node.order < orders[line]))) {
+				found[line] = node.station;
+				distances[line] = distance;
+				orders[line] = node.order;
+			}
+		}
+	}
+
+	//	search the side of the split that holds the point first
+	bool before = by_latitude ? latitude < node.latitude 
+														: longitude < node.longitude;
+	if (before) {
+		search(first, middle, !by_latitude, latitude, longitude, lines, found,
+					 distances, orders);
+		search(middle + 1, last, !by_latitude, latitude, longitude, lines, found,
+					 distances, orders);
+	} else {
+		search(middle + 1, last, !by_latitude, latitude, longitude, lines, found,
+					 distances, orders);
+		search(first, middle, !by_latitude, latitude, longitude, lines, found,
+					 distances, orders);
+	}
+}
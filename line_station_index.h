@@ -0,0 +1,160 @@
+/*******************************************************************************
+  Title          : line_station_index.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the LineStationIndex class
+  Purpose        : To find the closest station to a point at which a given
+									 train line stops
+  Usage          : Build a LineStationIndex object from a SubwaySystem object's
+									 stations and call nearest with a latitude and longitude 
+									 point and a mask of the lines to search
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __LINE_STATION_INDEX_H__
+#define __LINE_STATION_INDEX_H__
+
+#include <vector>
+#include "subway_entrance.h"
+#include "subway_station.h"
+
+/*******************************************************************************
+
+		The LineStationIndex class is a k-d tree of stations that answers nearest
+		station queries for each train line separately. The tree is balanced and
+		stored without pointers: the stations of a subtree are a range of a 
+		vector, its root is the station in the middle of the range, and the 
+		stations before and after the middle are its two subtrees, split by 
+		latitude and longitude in turn. Each subtree also stores the box of 
+		latitudes and longitudes that holds its stations, and the 32-bit mask of
+		the lines that stop at any of them.
+
+		The mask makes the one tree act as a separate index for every line: a 
+		search for one line skips every subtree in which that line never stops, 
+		and a search for several lines at once keeps the closest station found so 
+		far for each of them, and skips a subtree once its box is farther than 
+		the closest station of every line it contains. Searching all 26 lines in 
+		one traversal visits each subtree at most once, instead of once per line.
+		Distances are haversine distances to the stations' coordinates, the same
+		as SubwayStationHash::nearest_station, and when two stations of a line 
+		are equally close, the one that comes first in the vector the index was 
+		built from is chosen. A built LineStationIndex is never modified by a 
+		search, so any number of threads can search it at the same time.
+
+		When some of the stations change, update removes them from their nodes
+		and puts the new ones into empty nodes, going down from the root on the
+		side of each split that holds the station while that side has an empty
+		node, and then sets the boxes and masks on the way back up to the root
+		again. Searches only rely on the boxes and masks, so a station does not
+		have to be on the right side of every split above it. A node keeps the
+		coordinates it was split at when it is emptied. Only when no empty node
+		is left is the tree built again, with an empty node for every three
+		stations, at the coordinates of one of them, so that the stations added
+		before that pay for it.
+
+*******************************************************************************/
+
+class LineStationIndex {
+ public:
+	//	Creates an empty LineStationIndex object
+	LineStationIndex();
+
+	//	Destroys LineStationIndex object
+	~LineStationIndex();
+
+	//	Builds the index of stations, replacing the previous index, if any. The
+	//	stations must exist for as long as the index is used
+	void build(const std::vector<const SubwayStation*>& stations);
+
+	//	Brings the index of stations up to date after the stations at the 
+	//	positions in changed have been replaced, added or removed. A position 
+	//	in changed that is not less than the size of stations was removed. The
+	//	positions of the other stations must not have changed
+	void update(const std::vector<const SubwayStation*>& stations,
+							const std::vector<unsigned int>& changed);
+
+	//	Points the index at stations after the stations it holds have moved to 
+	//	other addresses. The stations at positions that are not less than the 
+	//	size of stations are left for the next update to remove
+	void relink(const std::vector<const SubwayStation*>& stations);
+
+	//	For every line in the 32-bit mask lines, sets found[line] to the closest
+	//	station on that line to the given latitude and longitude point and 
+	//	distances[line] to its distance in kilometers. found and distances are
+	//	resized to hold an entry for every LineValue; the entries of the other 
+	//	lines, and of lines that stop at no station, are NULL and HUGE_VAL
+	void nearest(double latitude, double longitude, unsigned long lines,
+							 std::vector<const SubwayStation*>& found,
+							 std::vector<double>& distances) const;
+
+ private:
+	//	A station of the tree and the subtree whose root it is
+	struct Node {
+		//	The station and its coordinates, or NULL and the coordinates the node
+		//	splits its subtree at if the node is empty
+		const SubwayStation* station;
+		double latitude;
+		double longitude;
+
+		//	The position of the station in the vector the index was built from
+		unsigned int order;
+
+		//	The box that holds every station of the subtree
+		double min_latitude;
+		double max_latitude;
+		double min_longitude;
+		double max_longitude;
+
+		//	32-bit mask of the lines that stop at any station of the subtree
+		unsigned long lines;
+
+		//	The number of empty nodes in the subtree
+		unsigned int room;
+	};
+
+	//	The node of a position that has no station
+	static const unsigned int kNoNode = 0xffffffff;
+
+	//	The nodes of the tree; the root of the subtree of nodes_[first] to
+	//	nodes_[last - 1] is nodes_[(first + last) / 2]
+	std::vector<Node> nodes_;
+
+	//	The index in nodes_ of the station at each position, or kNoNode
+	std::vector<unsigned int> nodes_of_;
+
+	//	Builds the tree of stations, with an empty node at the coordinates of
+	//	every slack-th station if slack is not 0
+	void build(const std::vector<const SubwayStation*>& stations,
+						 unsigned int slack);
+
+	//	Arranges nodes_[first] to nodes_[last - 1] into a subtree split by
+	//	latitude if by_latitude is true, or by longitude otherwise, and sets 
+	//	the boxes and masks of its nodes
+	void build(unsigned int first, unsigned int last, bool by_latitude);
+
+	//	Sets the box, mask and room of the root of the subtree of nodes_[first]
+	//	to nodes_[last - 1] from its station and the roots of its two subtrees
+	void refresh(unsigned int first, unsigned int last);
+
+	//	Refreshes the subtrees on the way from the root down to nodes_[node],
+	//	from the bottom up
+	void refresh_path(unsigned int node);
+
+	//	Puts the station at position into an empty node, and returns false if
+	//	there is none
+	bool insert(unsigned int position, const SubwayStation* station);
+
+	//	Searches the subtree of nodes_[first] to nodes_[last - 1] for the lines
+	//	in the mask lines, updating found and distances, and orders, which holds
+	//	the order of each line's station in found
+	void search(unsigned int first, unsigned int last, bool by_latitude,
+							double latitude, double longitude, unsigned long lines,
+							std::vector<const SubwayStation*>& found,
+							std::vector<double>& distances, 
+							unsigned int orders[]) const;
+};
+
+#endif
+
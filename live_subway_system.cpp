@@ -0,0 +1,169 @@
+/*******************************************************************************
+  Title          : live_subway_system.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the LiveSubwaySystem class
+  Purpose        : To replace the subway system that queries are answered
+									 from with a newly made one while queries keep running
+  Usage          : Publish a made SubwaySystem object, read it through a
+									 LiveSubwaySystem::Reader object for each query, and call
+									 reload to make and publish a new one in the background
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "live_subway_system.h"
+#include "trace.h"
+
+//	The epoch a slot holds while its thread is not reading
+static const uint64_t kIdle = 0;
+
+//	The epoch of a reading thread, padded to a cache line so that threads do
+//	not write to the same one. A slot belongs to one thread at a time, and
+//	only that thread touches depth
+struct ReaderSlot {
+	std::atomic<uint64_t> epoch;
+	std::atomic<bool> owned;
+	ReaderSlot* next;
+	unsigned int depth;
+	char padding[36];
+};
+
+//	The list of every slot ever made, which only grows
+static std::atomic<ReaderSlot*> slots(NULL);
+
+//	The current epoch, which is never kIdle
+static std::atomic<uint64_t> epoch(1);
+
+//	Gives up the calling thread's slot when the thread exits
+struct SlotOwner {
+	ReaderSlot* slot;
+	~SlotOwner() {
+		if (slot) {
+			slot->owned.store(false);
+		}
+	}
+};
+static thread_local SlotOwner owner = { NULL };
+
+//	Returns the calling thread's slot, taking a free one or making one the
+//	first time the thread reads
+static ReaderSlot* reader_slot() {
+	if (owner.slot) {
+		return owner.slot;
+	}
+	for (ReaderSlot* s = slots.load(); s; s = s->next) {
+		bool owned = false;
+		if (!s->owned.load() && s->owned.compare_exchange_strong(owned, true)) {
+			owner.slot = s;
+			return s;
+		}
+	}
+	ReaderSlot* s = new ReaderSlot();
+	s->epoch.store(kIdle);
+	s->owned.store(true);
+	s->depth = 0;
+	s->next = slots.load();
+	while (!slots.compare_exchange_weak(s->next, s)) {
+	}
+	owner.slot = s;
+	return s;
+}
+
+LiveSubwaySystem::Reader::Reader(const LiveSubwaySystem& live) : system_(NULL)
+{
+	ReaderSlot* slot = reader_slot();
+	if (slot->depth++ == 0) {
+		//	the epoch is written before the version is read, so a publish that
+		//	swaps the version after this sees the slot
+		slot->epoch.store(epoch.load());
+	}
+	system_ = live.current_.load();
+}
+
+LiveSubwaySystem::Reader::~Reader() {
+	ReaderSlot* slot = owner.slot;
+	if (--slot->depth == 0) {
+		slot->epoch.store(kIdle, std::memory_order_release);
+	}
+}
+
+const SubwaySystem& LiveSubwaySystem::Reader::operator*() const {
+	return *system_;
+}
+
+const SubwaySystem* LiveSubwaySystem::Reader::operator->() const {
+	return system_;
+}
+
+LiveSubwaySystem::LiveSubwaySystem() : current_(NULL), versions_(0),
+    publish_lock_(), reloader_(), reloading_(false), reload_lock_()
+{
+}
+
+LiveSubwaySystem::~LiveSubwaySystem() {
+	wait();
+	delete current_.load();
+}
+
+void LiveSubwaySystem::publish(SubwaySystem* system) {
+	TRACE_SPAN("publish");
+	std::lock_guard<std::mutex> guard(publish_lock_);
+	SubwaySystem* old = current_.exchange(system);
+	++versions_;
+	if (old) {
+		wait_for_readers(epoch.fetch_add(1) + 1);
+		delete old;
+	}
+}
+
+bool LiveSubwaySystem::reload(const std::function<SubwaySystem*()>& make) {
+	std::unique_lock<std::mutex> guard(reload_lock_, std::try_to_lock);
+	if (!guard.owns_lock() || reloading_.exchange(true)) {
+		return false;
+	}
+	//	the last reload has finished, so this only waits for its thread to
+	//	exit
+	if (reloader_.joinable()) {
+		reloader_.join();
+	}
+	reloader_ = std::thread([this, make]() {
+		SubwaySystem* system = make();
+		if (system) {
+			publish(system);
+		}
+		reloading_.store(false);
+	});
+	return true;
+}
+
+void LiveSubwaySystem::wait() {
+	std::lock_guard<std::mutex> guard(reload_lock_);
+	if (reloader_.joinable()) {
+		reloader_.join();
+	}
+}
+
+unsigned long LiveSubwaySystem::versions() const {
+	return versions_.load();
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void LiveSubwaySystem::wait_for_readers(uint64_t new_epoch) {
+	TRACE_SPAN("wait_for_readers");
+	//	a reader that wrote new_epoch or a later one read the epoch after it
+	//	was advanced, and so the version after it was swapped
+	for (ReaderSlot* s = slots.load(); s; s = s->next) {
+		uint64_t e = s->epoch.load();
+		while (e != kIdle && e < new_epoch) {
+			std::this_thread::yield();
+			e = s->epoch.load();
+		}
+	}
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+  Title          : live_subway_system.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the LiveSubwaySystem class
+  Purpose        : To replace the subway system that queries are answered
+									 from with a newly made one while queries keep running
+  Usage          : Publish a made SubwaySystem object, read it through a
+									 LiveSubwaySystem::Reader object for each query, and call
+									 reload to make and publish a new one in the background
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __LIVE_SUBWAY_SYSTEM_H__
+#define __LIVE_SUBWAY_SYSTEM_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "subway_system.h"
+
+/*******************************************************************************
+
+		The LiveSubwaySystem class holds the current version of a subway system
+		that is being queried, and lets a new version replace it without
+		stopping the queries, in the manner of read-copy-update. A version is a
+		SubwaySystem object that has been made and is never modified again; the
+		LiveSubwaySystem object owns it from the time it is published.
+
+		A query reads the current version through a Reader object, which it
+		keeps for as long as it uses the version. Creating a Reader never waits
+		and never takes a lock: the reading thread writes the current epoch, a
+		counter that publish advances, into a slot of its own, and reads the
+		pointer to the current version. Destroying the Reader marks the slot
+		idle. Publishing a new version swaps the pointer, advances the epoch and
+		waits until every slot is idle or holds the new epoch, because only
+		readers that entered before the swap can still be using the old
+		version, and then destroys the old version. Only the publishing thread
+		waits.
+
+		reload makes a new version on a background thread and publishes it, so
+		neither the making nor the waiting happens on a querying thread. A
+		reload is refused while another is running, so at most three versions
+		exist at once: the current one, the one being made and the one whose
+		readers are finishing. Readers can be nested on one thread, and slots
+		are reused by later threads once their thread exits.
+
+*******************************************************************************/
+
+class LiveSubwaySystem {
+ public:
+	//	Gives the calling thread read access to the current version for as long
+	//	as it exists
+	class Reader {
+	 public:
+		//	Starts reading the current version of live, which must have one
+		explicit Reader(const LiveSubwaySystem& live);
+
+		//	Ends the read
+		~Reader();
+
+		//	Return the version being read
+		const SubwaySystem& operator*() const;
+		const SubwaySystem* operator->() const;
+
+	 private:
+		Reader(const Reader&);
+		Reader& operator=(const Reader&);
+
+		//	The version being read
+		const SubwaySystem* system_;
+	};
+
+	//	Creates a LiveSubwaySystem object with no version
+	LiveSubwaySystem();
+
+	//	Waits for a reload in progress, if any, and destroys the current
+	//	version. No Reader may exist
+	~LiveSubwaySystem();
+
+	//	Makes system, which must have been made, the version that readers get
+	//	from now on, waits for the readers of the previous version to finish
+	//	and destroys it. Publishes made by several threads take turns
+	void publish(SubwaySystem* system);
+
+	//	Calls make on a background thread and publishes the version it returns,
+	//	unless it returns NULL. Returns false without calling make if the
+	//	previous reload has not finished. Never blocks, so it can be called
+	//	from a thread that answers queries
+	bool reload(const std::function<SubwaySystem*()>& make);
+
+	//	Blocks until the reload in progress, if any, has finished
+	void wait();
+
+	//	Returns the number of versions published so far
+	unsigned long versions() const;
+
+ private:
+	LiveSubwaySystem(const LiveSubwaySystem&);
+	LiveSubwaySystem& operator=(const LiveSubwaySystem&);
+
+	//	The current version
+	std::atomic<SubwaySystem*> current_;
+
+	//	Number of versions published
+	std::atomic<unsigned long> versions_;
+
+	//	Makes publishes take turns
+	std::mutex publish_lock_;
+
+	//	The thread of the last reload, whether it is still running, and the 
+	//	lock that protects the thread object
+	std::thread reloader_;
+	std::atomic<bool> reloading_;
+	std::mutex reload_lock_;
+
+	//	Blocks until no reader that started before the epoch was advanced to 
+	//	new_epoch is still reading
+	static void wait_for_readers(uint64_t new_epoch);
+};
+
+#endif
@@ -11,9 +11,9 @@
 									 SubwaySystem object. The SubwaySystem object's 
 									 make_subway_system method will then be called to create the 
 									 subway system and will then execute each command in the 
-									 command file. A Command object is used to parse the file
-									 containing the list of commands, and get each command and its
-									 arguments from each line. The arguments are then given to the
+									 command file. A CommandFile object is used to parse the
+									 file containing the list of commands, and get each command and
+									 its arguments from each line. The arguments are then given to the
 									 SubwaySystem object method that corresponds to each command
 									 and the command is executed.
   Purpose        : To store and use the contents of a New York City subway 
@@ -22,23 +22,131 @@
 									 queries pertaining to the database
   Usage          : When running, provide two input files, the NYC Subway 
 									 entrances file and a file with a list of commands, 
-									 respectively
-  Build with     : g++ -std=c++11 -o main main.cpp subway_entrance.cpp 
-									 subway_station.cpp subway_line.cpp subway_station_hash.cpp 
-									 subway_line_hash.cpp subway_system.cpp command.o
+									 respectively. Optionally, provide --jobs N before the
+									 files to run the commands on N threads; their output is
+									 still displayed in the order of the command file. 
+									 Provide --cache N to cache up to N nearest query answers,
+									 --cache-precision P to set the cache's cell size to P
+									 degrees and --cache-exact to only reuse answers for
+									 identical coordinates. Provide --hierarchy to preprocess
+									 the stations into a contraction hierarchy that answers
+									 route commands faster. Provide --distances to load the
+									 distances between every pair of stations from the file
+									 named after the subway file with ".distances" added, 
+									 computing and saving them there first if needed. Provide
+									 --warm to build every index before the first command on
+									 all hardware threads, instead of when a command first 
+									 needs it. Provide --stats to display the number of 
+									 commands of each kind, their latency percentiles and the
+									 mean size of their answers on standard error at exit, 
+									 and whenever the process receives SIGUSR1. In a build
+									 with tracing (make OPT=-DSUBWAY_TRACE), provide --trace
+									 FILE to write a Chrome trace of building the subway 
+									 system and of every command to FILE, or of every Nth
+									 command with --trace-sample N. Provide --hash-stats to
+									 display how the stations and lines are spread over their
+									 hash tables on standard error. Provide --alloc-stats to
+									 display the heap allocations of each step of building the
+									 subway system and of each kind of command on standard 
+									 error at exit, and with --stats on SIGUSR1. Provide 
+									 --delta FILE, as many times as needed, to add and remove
+									 the entrances listed in FILE after the subway system is
+									 made, without making it again. Provide --reload to make
+									 the subway system again from its files whenever the 
+									 process receives SIGHUP, in the background, and switch 
+									 the commands over to it without pausing them. The 
+									 subway file is always read, its entrances grouped into
+									 stations and the subway system made on all hardware
+									 threads
+  Build with     : make
   Modifications  : 
  
 *******************************************************************************/
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <signal.h>
 #include <stdlib.h>
-#include <fstream>
 #include <sstream>
 #include <vector>
 #include <string>
 #include "subway_entrance.h"
 #include "subway_system.h"
+#include "live_subway_system.h"
+#include "query_scratch.h"
+#include "work_pool.h"
+#include "query_stats.h"
+#include "trace.h"
+#include "alloc_stats.h"
 #include "command.h"
+#include "command_file.h"
+#include "subway_file.h"
+
+//	Executes command, which was parsed from file, on subway_system and writes
+//	its output to out
+void execute(const SubwaySystem& subway_system, const CommandFile& file,
+						 const CommandRecord& command, std::ostream& out,
+						 QueryScratch& scratch);
+
+//	Executes command, the index-th of the command file, like execute does on
+//	the current version of live, counting its allocations in the scope of its
+//	kind. If stats is not NULL, also records in shard shard of stats how long
+//	the command took, the number of stations, entrances and lines in its 
+//	answer and the number of candidates it examined, and displays the 
+//	statistics if SIGUSR1 asked for them. If spans are being recorded, every
+//	trace_sample-th command is traced. If SIGHUP asked for the subway system 
+//	to be made again, starts reloading it first
+void execute_measured(LiveSubwaySystem& live, const CommandFile& file,
+											const CommandRecord& command, unsigned int index, 
+											std::ostream& out, QueryScratch& scratch, 
+											QueryStats* stats, unsigned int shard);
+
+//	Executes every command in commands on live using jobs threads and 
+//	displays their output in the same order as commands. Each thread records 
+//	into its own shard of stats, if stats is not NULL
+void execute_all(LiveSubwaySystem& live, const CommandFile& file,
+								 const std::vector<CommandRecord>& commands, unsigned int jobs,
+								 QueryStats* stats);
+
+//	Set when SIGUSR1 asks for the statistics to be displayed
+static std::atomic<bool> stats_requested(false);
+
+//	Set when SIGHUP asks for the subway system to be made again, and what 
+//	makes it
+static std::atomic<bool> reload_requested(false);
+static std::function<SubwaySystem*()> remake;
+
+//	Every how many commands one is traced
+static unsigned int trace_sample = 1;
+
+//	The allocation scope of each kind of command
+static std::vector<unsigned int> command_scopes;
+
+//	Displays stats, if it is not NULL, and the allocations if they are counted,
+//	on standard error
+static void display_stats(const QueryStats* stats) {
+	if (stats) {
+		stats->display(std::cerr);
+	}
+	if (AllocStats::enabled()) {
+		AllocStats::display(std::cerr);
+	}
+}
+
+//	Handles SIGUSR1 by asking for the statistics to be displayed after the
+//	next command
+static void request_stats(int) {
+	stats_requested.store(true);
+}
+
+//	Handles SIGHUP by asking for the subway system to be made again before the
+//	next command
+static void request_reload(int) {
+	reload_requested.store(true);
+}
 
 int main(int argc, char* argv[]) {
 /*
@@ -135,130 +243,224 @@ int main(int argc, char* argv[]) {
 	//subway_system.list_all_stations();
 	//cout << endl;
 */
-	if(3 == argc) {
-		std::ifstream subway_file;
-		std::ifstream command_file;
-		subway_file.open(argv[1]);
-		command_file.open(argv[2]);
-		if (subway_file.fail()) {
-			std::cerr << "Unable to open subway file: " << argv[1] << std::endl;
-			exit(1);
-		}
-		if (command_file.fail()) {
-			std::cerr << "Unable to open commands file: " << argv[2] << std::endl;
-			exit(1);
+	unsigned int jobs = 1;
+	unsigned int cache_size = 0;
+	double cache_precision = 1e-4;
+	bool verify_cells = true;
+	bool hierarchy = false;
+	bool distances = false;
+	bool warm = false;
+	bool show_stats = false;
+	bool alloc_stats = false;
+	std::string trace_path;
+	bool hash_stats = false;
+	bool reload = false;
+	std::vector<char*> deltas;
+	std::vector<char*> files;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--jobs") {
+			long n = (i + 1 < argc) ? strtol(argv[i + 1], NULL, 10) : 0;
+			if (n < 1) {
+				std::cerr << "ERROR: --jobs must be followed by a positive number of ";
+				std::cerr << "threads" << std::endl;
+				exit(1);
+			}
+			jobs = n;
+			++i;
+		} else if (arg == "--cache") {
+			long n = (i + 1 < argc) ? strtol(argv[i + 1], NULL, 10) : 0;
+			if (n < 1) {
+				std::cerr << "ERROR: --cache must be followed by a positive number of ";
+				std::cerr << "answers" << std::endl;
+				exit(1);
+			}
+			cache_size = n;
+			++i;
+		} else if (arg == "--cache-precision") {
+			double p = (i + 1 < argc) ? strtod(argv[i + 1], NULL) : 0;
+			if (!(p > 0)) {
+				std::cerr << "ERROR: --cache-precision must be followed by a positive ";
+				std::cerr << "number of degrees" << std::endl;
+				exit(1);
+			}
+			cache_precision = p;
+			++i;
+		} else if (arg == "--cache-exact") {
+			verify_cells = false;
+		} else if (arg == "--hierarchy") {
+			hierarchy = true;
+		} else if (arg == "--distances") {
+			distances = true;
+		} else if (arg == "--warm") {
+			warm = true;
+		} else if (arg == "--stats") {
+			show_stats = true;
+		} else if (arg == "--alloc-stats") {
+			alloc_stats = true;
+		} else if (arg == "--hash-stats") {
+			hash_stats = true;
+		} else if (arg == "--reload") {
+			reload = true;
+		} else if (arg == "--trace") {
+			if (i + 1 >= argc) {
+				std::cerr << "ERROR: --trace must be followed by the name of the ";
+				std::cerr << "trace file" << std::endl;
+				exit(1);
+			}
+			trace_path = argv[++i];
+		} else if (arg == "--delta") {
+			if (i + 1 >= argc) {
+				std::cerr << "ERROR: --delta must be followed by the name of the ";
+				std::cerr << "delta file" << std::endl;
+				exit(1);
+			}
+			deltas.push_back(argv[++i]);
+		} else if (arg == "--trace-sample") {
+			long n = (i + 1 < argc) ? strtol(argv[i + 1], NULL, 10) : 0;
+			if (n < 1) {
+				std::cerr << "ERROR: --trace-sample must be followed by a positive ";
+				std::cerr << "number of commands" << std::endl;
+				exit(1);
+			}
+			trace_sample = n;
+			++i;
+		} else {
+			files.push_back(argv[i]);
 		}
+	}
 
-		SubwaySystem subway_system;
-		int entrance_id;
-		double latitude, longitude;
-		std::string website, name, a_line, data;
-		std::vector<std::string> train_lines;
+#ifndef SUBWAY_TRACE
+	if (!trace_path.empty()) {
+		std::cerr << "ERROR: --trace needs a build with tracing: ";
+		std::cerr << "make cleanall && make OPT=-DSUBWAY_TRACE" << std::endl;
+		exit(1);
+	}
+#endif
 
-		while (subway_file.is_open()) {
-			std::getline(subway_file, a_line);
+	for (int i = 0; i < num_Command_types; ++i) {
+		command_scopes.push_back(AllocStats::scope(command_name((Command_type)i)));
+	}
+	if (alloc_stats) {
+		AllocStats::enable();
+	}
 
-			if (subway_file.eof()) {
-				break;
-			}
+	if(2 == files.size()) {
+		if (!trace_path.empty()) {
+			Trace::start();
+		}
+		CommandFile command_file;
+		bool command_file_open = command_file.open(files[1]);
 
-			unsigned int start = 0, count = 1;
-			for (unsigned int i = 0; i < a_line.length(); ++i) {
-				if (a_line[i] == ',') {
-					data = a_line.substr(start, i - start);
-					if (count != 3) {
-						std::istringstream ss1(data);
-						if (1 == count) {
-							ss1 >> entrance_id;
-						} else if (2 == count) {
-							ss1 >> website;
-						} else if (4 == count) {
-							unsigned int begin = 7;
-							for (unsigned int j = 7; j < data.length(); ++j) {
-								if (data[j] == ' ') {
-									std::istringstream ss2(data.substr(begin, j - begin));
-									ss2 >> longitude;
-									begin = j + 1;
-								} else if (j == data.length() - 1) {
-									std::istringstream ss2(data.substr(begin));
-									ss2 >> latitude;
-								}
-							}
-						}
-					} else {
-						name = data;
-					}
-					start = i + 1;
-					++count;
-				} else if (i == a_line.length() - 1) {
-					data = a_line.substr(start);
-					if (data.length() == 1 || data == "SIR" || data == "FS") {
-						train_lines.push_back(data);
-					} else {
-						unsigned int begin = 0;
-						for (unsigned int k = 0; k < data.length(); ++k) {
-							if (data[k] == '-') {
-								train_lines.push_back(data.substr(begin, k - begin));
-								begin = k + 1;
-							} else if (k == data.length() - 1) {
-								train_lines.push_back(data.substr(begin));
-							}
-						}
-					}
+		//	makes the subway system from the subway file and the delta files, 
+		//	with every option given, or returns NULL if a file cannot be read. 
+		//	A reload calls it again on a thread of its own
+		auto make = [&]() -> SubwaySystem* {
+			std::unique_ptr<SubwaySystem> subway_system(new SubwaySystem());
+			if (!read_subway_file(files[0], *subway_system, 0)) {
+				std::cerr << "Unable to open subway file: " << files[0] << std::endl;
+				return NULL;
+			}
+			subway_system->make_subway_system(0);
+			for (auto& path : deltas) {
+				std::vector<Entrance> adds;
+				std::vector<int> removes;
+				if (!read_delta_file(path, adds, removes)) {
+					std::cerr << "Unable to open delta file: " << path << std::endl;
+					return NULL;
 				}
+				unsigned int removed = subway_system->apply_delta(adds, removes);
+				std::cerr << "Delta " << path << ": " << adds.size();
+				std::cerr << " entrances added, " << removed << " removed, ";
+				std::cerr << subway_system->stations() << " stations" << std::endl;
+			}
+			if (hash_stats) {
+				subway_system->hash_statistics(std::cerr);
+			}
+			if (warm) {
+				subway_system->warm();
+			}
+			if (cache_size > 0) {
+				subway_system->enable_cache(cache_size, cache_precision, 
+																		verify_cells);
+			}
+			if (hierarchy) {
+				subway_system->enable_hierarchy();
+			}
+			if (distances) {
+				std::string path = std::string(files[0]) + ".distances";
+				bool loaded = subway_system->enable_distances(path, jobs);
+				std::cerr << "Distances between " << subway_system->stations();
+				std::cerr << " stations ";
+				std::cerr << (loaded ? "loaded from " + path : "computed");
+				std::cerr << std::endl;
 			}
+			return subway_system.release();
+		};
 
-			Entrance entrance(entrance_id, website, name, latitude, longitude,
-												train_lines);
-			train_lines.clear();
-			subway_system.add(entrance);
+		SubwaySystem* first = make();
+		if (!first) {
+			exit(1);
+		}
+		if (!command_file_open) {
+			std::cerr << "Unable to open commands file: " << files[1] << std::endl;
+			exit(1);
+		}
+		LiveSubwaySystem live;
+		live.publish(first);
+		if (reload) {
+			hash_stats = false;
+			remake = make;
+			signal(SIGHUP, request_reload);
 		}
-		subway_system.make_subway_system();
 
+		std::vector<CommandRecord> commands;
+		{
+			ALLOC_SCOPE("parse_commands");
+			if (!command_file.parse(commands)) {
+				std::cerr << "Could not get next command.\n";
+			}
+		}
 
-		Command command;
-    std::string station_name, identifier;
-    bool result;
+		std::unique_ptr<QueryStats> stats;
+		if (show_stats) {
+			std::vector<std::string> names;
+			for (int i = 0; i < num_Command_types; ++i) {
+				names.push_back(command_name((Command_type)i));
+			}
+			stats.reset(new QueryStats(names, jobs));
+			signal(SIGUSR1, request_stats);
+		}
 
-		while (!command_file.eof()) {
-			if (!command.get_next(command_file)) {
-				if (!command_file.eof()) {
-					std::cerr << "Could not get next command.\n";
+		{
+			TRACE_SPAN("commands");
+			if (1 == jobs) {
+				QueryScratch scratch;
+				for (unsigned int i = 0; i < commands.size(); ++i) {
+					execute_measured(live, command_file, commands[i], i, 
+													 std::cout, scratch, stats.get(), 0);
 				}
-				return 1;
-			}
-			command.get_args(identifier, station_name, longitude, latitude, result);
-
-			switch (command.type_of()) {
-				case list_line_stations_cmmd:
-					subway_system.list_line_stations(identifier);
-					break;
-				case list_all_stations_cmmd:
-					subway_system.list_all_stations();
-					break;
-				case list_entrances_cmmd:
-					subway_system.list_entrances(station_name);
-					break;
-				case nearest_station_cmmd:
-					subway_system.nearest_station(latitude, longitude);
-					break;
-				case nearest_lines_cmmd:
-					subway_system.nearest_line(latitude, longitude);
-					break;
-				case nearest_entrance_cmmd:
-					subway_system.nearest_entrance(latitude, longitude);
-					break;
-				case bad_cmmd:
-					std::cout << "Invalid command" << std::endl;
-					break;
-				default:
-					break;
+			} else {
+				execute_all(live, command_file, commands, jobs, stats.get());
 			}
 		}
 
-		subway_file.close();
-		command_file.close();
-	} else if (3 < argc) {
+		if (!trace_path.empty() && !Trace::write(trace_path)) {
+			std::cerr << "Unable to write trace file: " << trace_path << std::endl;
+		}
+
+		display_stats(stats.get());
+
+		live.wait();
+		LiveSubwaySystem::Reader subway_system(live);
+		if (subway_system->cache()) {
+			std::cerr << "Cache hits: " << subway_system->cache()->hits();
+			std::cerr << ", misses: " << subway_system->cache()->misses() << std::endl;
+		}
+		//	reading the command file has always ended by failing to read the
+		//	command after the last one, which makes the exit status 1
+		return 1;
+	} else if (2 < files.size()) {
 		std::cerr << "ERROR: Too many arguments provided. ";
 		std::cerr << "You must provide one input file and one command file, ";
 		std::cerr << "respectively." << std::endl;
@@ -270,3 +472,166 @@ int main(int argc, char* argv[]) {
 	}
 	return 0;
 }
+
+void execute(const SubwaySystem& subway_system, const CommandFile& file,
+						 const CommandRecord& command, std::ostream& out,
+						 QueryScratch& scratch) {
+	switch (command.type) {
+		case list_line_stations_cmmd:
+			subway_system.list_line_stations(file.argument(command), out, scratch);
+			break;
+		case list_all_stations_cmmd:
+			subway_system.list_all_stations(out, scratch);
+			break;
+		case list_entrances_cmmd:
+			subway_system.list_entrances(file.argument(command), out, scratch);
+			break;
+		case nearest_station_cmmd:
+			subway_system.nearest_station(command.latitude, command.longitude, out,
+																		scratch);
+			break;
+		case nearest_lines_cmmd:
+			subway_system.nearest_line(command.latitude, command.longitude, out,
+																 scratch);
+			break;
+		case nearest_entrance_cmmd:
+			subway_system.nearest_entrance(command.latitude, command.longitude, out,
+																		 scratch);
+			break;
+		case nearest_all_cmmd:
+			subway_system.nearest_all(command.latitude, command.longitude, out,
+																scratch);
+			break;
+		case route_cmmd: {
+			//	the two station names are separated by a comma
+			std::string names = file.argument(command);
+			std::string::size_type comma = names.find(',');
+			std::string from = names.substr(0, comma);
+			std::string::size_type start = names.find_first_not_of(' ', comma + 1);
+			std::string to = (start == std::string::npos) ? "" : names.substr(start);
+			from.erase(from.find_last_not_of(' ') + 1);
+			subway_system.route(from, to, out, scratch);
+			break;
+		}
+		case transfers_cmmd: {
+			std::istringstream lines(file.argument(command));
+			std::string from, to;
+			lines >> from >> to;
+			subway_system.transfers(from, to, out, scratch);
+			break;
+		}
+		case closest_line_cmmd:
+			subway_system.closest_line(command.latitude, command.longitude, out,
+																 scratch);
+			break;
+		case nearest_station_on_line_cmmd:
+			subway_system.nearest_station_on_line(command.latitude, 
+																						command.longitude,
+																						file.argument(command), out,
+																						scratch);
+			break;
+		case nearest_station_by_line_cmmd:
+			subway_system.nearest_station_by_line(command.latitude,
+																						command.longitude, out, scratch);
+			break;
+		case stations_in_box_cmmd:
+		case entrances_in_box_cmmd:
+			subway_system.in_box(command.latitude, command.longitude,
+													 command.to_latitude, command.to_longitude,
+													 command.type == entrances_in_box_cmmd, out, scratch);
+			break;
+		case stations_in_polygon_cmmd:
+		case entrances_in_polygon_cmmd: {
+			//	the vertices are longitude and latitude pairs
+			std::istringstream numbers(file.argument(command));
+			std::vector<HilbertRTree::Vertex> polygon;
+			double longitude, latitude;
+			while (numbers >> longitude >> latitude) {
+				polygon.push_back(HilbertRTree::Vertex(latitude, longitude));
+			}
+			subway_system.in_polygon(polygon, 
+															 command.type == entrances_in_polygon_cmmd, out,
+															 scratch);
+			break;
+		}
+		case walk_route_cmmd:
+			subway_system.walk_route(command.latitude, command.longitude,
+															 command.to_latitude, command.to_longitude, out,
+															 scratch);
+			break;
+		case bad_cmmd:
+			out << "Invalid command" << std::endl;
+			break;
+		default:
+			break;
+	}
+}
+
+void execute_measured(LiveSubwaySystem& live, const CommandFile& file,
+											const CommandRecord& command, unsigned int index, 
+											std::ostream& out, QueryScratch& scratch, 
+											QueryStats* stats, unsigned int shard) {
+	if (reload_requested.load(std::memory_order_relaxed) && 
+			reload_requested.exchange(false) && live.reload(remake)) {
+		std::cerr << "Reloading the subway system" << std::endl;
+	}
+	LiveSubwaySystem::Reader subway_system(live);
+#ifdef SUBWAY_TRACE
+	std::unique_ptr<TraceSpan> span;
+	if (index % trace_sample == 0 && Trace::recording()) {
+		span.reset(new TraceSpan(command_name(command.type), 
+														 std::to_string(index + 1)));
+	}
+#else
+	(void)index;
+#endif
+	if (!stats) {
+		AllocScope scope(command_scopes[command.type]);
+		execute(*subway_system, file, command, out, scratch);
+		return;
+	}
+	{
+		AllocScope scope(command_scopes[command.type]);
+		//	start from an empty answer so that commands that leave part of 
+		//	scratch alone are not counted with the answer of the command before 
+		//	them
+		scratch.clear();
+		std::chrono::steady_clock::time_point start = 
+			std::chrono::steady_clock::now();
+		execute(*subway_system, file, command, out, scratch);
+		uint64_t nanoseconds = 
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+		uint64_t results = scratch.stations.size() + scratch.entrances.size() +
+											 __builtin_popcountl(scratch.lines);
+		stats->record(shard, command.type, nanoseconds, results, scratch.probes);
+	}
+	if (stats_requested.exchange(false)) {
+		display_stats(stats);
+	}
+}
+
+void execute_all(LiveSubwaySystem& live, const CommandFile& file,
+								 const std::vector<CommandRecord>& commands, unsigned int jobs,
+								 QueryStats* stats) {
+	//	each command writes into its own buffer, and the buffers are displayed in
+	//	order once every command has been executed
+	std::vector<std::string> output(commands.size());
+	WorkPool pool(jobs);
+	std::vector<QueryScratch> scratch(pool.size());
+	std::vector<std::ostringstream> out(pool.size());
+
+	pool.parallel_for(0, commands.size(), 64,
+		[&](unsigned int worker, unsigned int first, unsigned int last) {
+			for (unsigned int i = first; i < last; ++i) {
+				out[worker].str("");
+				execute_measured(live, file, commands[i], i, out[worker],
+												 scratch[worker], stats, worker);
+				output[i] = out[worker].str();
+			}
+		});
+
+	for (auto& text : output) {
+		std::cout.write(text.data(), text.size());
+	}
+}
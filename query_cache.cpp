@@ -0,0 +1,176 @@
+/*******************************************************************************
+  Title          : query_cache.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the QueryCache class
+  Purpose        : To avoid repeating nearest station, line and entrance scans
+									 for coordinates that have already been queried
+  Usage          : Enable it on a SubwaySystem object with enable_cache
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "query_cache.h"
+#include "haversine.h"
+#include <algorithm>
+#include <cmath>
+
+//	Number of independently locked parts of the cache
+static const unsigned int kShards = 16;
+
+QueryCache::QueryCache(unsigned int capacity, double precision,
+											 bool verify_cells) : shards_(),
+    shard_capacity_((capacity + kShards - 1) / kShards), precision_(precision),
+    verify_cells_(verify_cells), hits_(0), misses_(0) {
+	if (shard_capacity_ == 0) {
+		shard_capacity_ = 1;
+	}
+	for (unsigned int i = 0; i < kShards; ++i) {
+		shards_.push_back(std::unique_ptr<Shard>(new Shard()));
+	}
+}
+
+QueryCache::~QueryCache()
+{
+}
+
+bool QueryCache::lookup(QueryKind kind, const double& latitude,
+												const double& longitude, QueryScratch& scratch) {
+	if (!std::isfinite(latitude) || !std::isfinite(longitude)) {
+		++misses_;
+		return false;
+	}
+	Key key = make_key(kind, latitude, longitude);
+	Shard& shard = shard_for(key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+
+	auto found = shard.index.find(key);
+	if (found == shard.index.end()) {
+		++misses_;
+		return false;
+	}
+	const Entry& entry = *found->second;
+	bool exact = (entry.latitude == latitude && entry.longitude == longitude);
+	if (!exact && !entry.whole_cell) {
+		++misses_;
+		return false;
+	}
+
+	//	mark it as the most recently used answer
+	shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+
+	scratch.stations = entry.stations;
+	scratch.entrances = entry.entrances;
+	scratch.lines = entry.lines;
+	if (exact) {
+		scratch.distance = entry.distance;
+		scratch.runner_up = entry.runner_up;
+	} else {
+		//	the answer is a single station or entrance, so only its distance to
+		//	this point has to be computed
+		double lat, lon;
+		if (kind == NEAREST_ENTRANCE) {
+			entry.entrances[0]->get_coordinates(lat, lon);
+		} else {
+			entry.stations[0]->get_coordinates(lat, lon);
+		}
+		scratch.distance = haversine(latitude, longitude, lat, lon);
+		scratch.runner_up = entry.runner_up -
+				haversine(latitude, longitude, entry.latitude, entry.longitude);
+	}
+	++hits_;
+	return true;
+}
+
+void QueryCache::store(QueryKind kind, const double& latitude,
+											 const double& longitude, const QueryScratch& scratch) {
+	if (!std::isfinite(latitude) || !std::isfinite(longitude)) {
+		return;
+	}
+	Key key = make_key(kind, latitude, longitude);
+	unsigned int answers = (kind == NEAREST_ENTRANCE) ? scratch.entrances.size()
+																									: scratch.stations.size();
+	bool whole_cell = verify_cells_ && answers == 1 &&
+										scratch.runner_up - scratch.distance > 2 * cell_width(key);
+
+	Shard& shard = shard_for(key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+
+	auto found = shard.index.find(key);
+	if (found != shard.index.end()) {
+		shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+	} else {
+		shard.entries.push_front(Entry());
+		shard.index[key] = shard.entries.begin();
+		if (shard.entries.size() > shard_capacity_) {
+			shard.index.erase(shard.entries.back().key);
+			shard.entries.pop_back();
+		}
+	}
+
+	Entry& entry = shard.entries.front();
+	entry.key = key;
+	entry.latitude = latitude;
+	entry.longitude = longitude;
+	entry.whole_cell = whole_cell;
+	entry.stations = scratch.stations;
+	entry.entrances = scratch.entrances;
+	entry.lines = scratch.lines;
+	entry.distance = scratch.distance;
+	entry.runner_up = scratch.runner_up;
+}
+
+void QueryCache::clear() {
+	for (auto& shard : shards_) {
+		std::lock_guard<std::mutex> guard(shard->lock);
+		shard->index.clear();
+		shard->entries.clear();
+	}
+}
+
+unsigned long QueryCache::hits() const {
+	return hits_;
+}
+
+unsigned long QueryCache::misses() const {
+	return misses_;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+size_t QueryCache::KeyHash::operator()(const Key& key) const {
+	unsigned long long value = key.kind;
+	value = value * 0x9E3779B97F4A7C15ULL + (unsigned long long)key.lat_cell;
+	value = value * 0x9E3779B97F4A7C15ULL + (unsigned long long)key.lon_cell;
+	return value ^ (value >> 29);
+}
+
+QueryCache::Key QueryCache::make_key(QueryKind kind, const double& latitude,
+																		 const double& longitude) const {
+	Key key;
+	key.kind = kind;
+	key.lat_cell = (long long)floor(latitude / precision_);
+	key.lon_cell = (long long)floor(longitude / precision_);
+	return key;
+}
+
+QueryCache::Shard& QueryCache::shard_for(const Key& key) {
+	return *shards_[KeyHash()(key) % shards_.size()];
+}
+
+double QueryCache::cell_width(const Key& key) const {
+	double lat1 = key.lat_cell * precision_;
+	double lon1 = key.lon_cell * precision_;
+	double lat2 = lat1 + precision_;
+	double lon2 = lon1 + precision_;
+	//	the diagonals are the longest lines in a cell; the small margin covers
+	//	rounding in haversine
+	double width = std::max(haversine(lat1, lon1, lat2, lon2),
+													haversine(lat1, lon2, lat2, lon1));
+	return width * 1.000001 + 1e-9;
+}
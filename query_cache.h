@@ -0,0 +1,153 @@
+/*******************************************************************************
+  Title          : query_cache.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the QueryCache class
+  Purpose        : To avoid repeating nearest station, line and entrance scans
+									 for coordinates that have already been queried
+  Usage          : Enable it on a SubwaySystem object with enable_cache
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __QUERY_CACHE_H__
+#define __QUERY_CACHE_H__
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "query_scratch.h"
+
+/*******************************************************************************
+
+		The QueryCache class is a least recently used cache of the answers to
+		nearest station, nearest line and nearest entrance queries. The earth is
+		divided into cells that are precision degrees of latitude tall and
+		precision degrees of longitude wide, and the cache keeps at most one
+		answer per query kind and cell. The cache never changes an answer:
+
+		-	An answer is returned for the exact coordinates it was computed for.
+		-	If cell verification is on, an answer is also returned for any other
+			point in the same cell, but only if the answer was proven to hold for
+			the whole cell when it was stored. That is the case when the answer is
+			a single station or entrance and the next closest one is farther away
+			than the answer by more than twice the width of the cell, because no
+			point in the cell can then be closer to the next one.
+
+		The cache is split into shards, each protected by its own lock, so threads
+		querying different cells rarely wait for each other. The hit and miss
+		counters can be read at any time.
+
+*******************************************************************************/
+
+//	The kinds of queries that QueryCache stores answers for
+enum QueryKind {
+	NEAREST_STATION = 0,
+	NEAREST_LINE,
+	NEAREST_ENTRANCE
+};
+
+class QueryCache {
+ public:
+	//	Creates a QueryCache object that holds at most capacity answers in cells
+	//	that are precision degrees wide. If verify_cells is false, answers are
+	//	only returned for the exact coordinates they were computed for
+	QueryCache(unsigned int capacity, double precision, bool verify_cells);
+
+	//	Destroys QueryCache object
+	~QueryCache();
+
+	//	If an answer for the given query is cached, copies it into scratch and
+	//	returns true. Otherwise returns false
+	bool lookup(QueryKind kind, const double& latitude, const double& longitude,
+							QueryScratch& scratch);
+
+	//	Stores the answer in scratch for the given query, replacing the answer
+	//	stored for its cell, if any
+	void store(QueryKind kind, const double& latitude, const double& longitude,
+						 const QueryScratch& scratch);
+
+	//	Removes every answer from QueryCache object
+	void clear();
+
+	//	Returns the number of lookups that found an answer
+	unsigned long hits() const;
+
+	//	Returns the number of lookups that did not find an answer
+	unsigned long misses() const;
+
+ private:
+	//	Identifies a cell for one kind of query
+	struct Key {
+		int kind;
+		long long lat_cell;
+		long long lon_cell;
+
+		bool operator==(const Key& other) const {
+			return kind == other.kind && lat_cell == other.lat_cell &&
+						 lon_cell == other.lon_cell;
+		}
+	};
+
+	//	Hash function for Key
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	//	An answer and the coordinates it was computed for
+	struct Entry {
+		Key key;
+		double latitude;
+		double longitude;
+		bool whole_cell;
+		std::vector<const SubwayStation*> stations;
+		std::vector<const Entrance*> entrances;
+		unsigned long lines;
+		double distance;
+		double runner_up;
+	};
+
+	//	A part of the cache with its own lock. entries is ordered from the most
+	//	to the least recently used answer
+	struct Shard {
+		std::mutex lock;
+		std::list<Entry> entries;
+		std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+	};
+
+	QueryCache(const QueryCache&);
+	QueryCache& operator=(const QueryCache&);
+
+	//	The shards of the cache
+	std::vector< std::unique_ptr<Shard> > shards_;
+
+	//	Largest number of answers kept in each shard
+	unsigned int shard_capacity_;
+
+	//	Width and height of a cell in degrees
+	double precision_;
+
+	//	True if answers may be returned for other points in their cell
+	bool verify_cells_;
+
+	std::atomic<unsigned long> hits_;
+	std::atomic<unsigned long> misses_;
+
+	//	Returns the key of the cell containing the given point
+	Key make_key(QueryKind kind, const double& latitude,
+							 const double& longitude) const;
+
+	//	Returns the shard that stores the answers for key
+	Shard& shard_for(const Key& key);
+
+	//	Returns the greatest distance in kilometers between two points of the
+	//	cell identified by key
+	double cell_width(const Key& key) const;
+};
+
+#endif
+
@@ -0,0 +1,127 @@
+/*******************************************************************************
+  Title          : query_scratch.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the QueryScratch struct
+  Purpose        : To provide per-thread working storage for SubwaySystem
+									 queries
+  Usage          : Create one QueryScratch object per thread and pass it to
+									 every SubwaySystem query made by that thread
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __QUERY_SCRATCH_H__
+#define __QUERY_SCRATCH_H__
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "subway_entrance.h"
+#include "subway_station.h"
+
+/*******************************************************************************
+
+		The QueryScratch struct holds the results of a single SubwaySystem query.
+		SubwaySystem never stores query results itself, so a built SubwaySystem
+		object is never modified by a query and any number of threads can query it
+		at the same time, as long as each thread uses its own QueryScratch object.
+		The vectors store pointers into the SubwaySystem object that answered the
+		query, so they are only valid for as long as that SubwaySystem object
+		exists. The vectors are cleared, not freed, before each query, so a
+		QueryScratch object that is reused stops allocating memory once its
+		vectors have grown large enough.
+
+*******************************************************************************/
+
+struct QueryScratch {
+	//	Stations that answer the last station query, such as the stations
+	//	that are tied for being the closest to a point
+	std::vector<const SubwayStation*> stations;
+
+	//	Entrances that answer the last entrance query
+	std::vector<const Entrance*> entrances;
+
+	//	32-bit mask of the lines that answer the last line query
+	unsigned long lines;
+
+	//	Distance in kilometers from the query point to the answer of the last
+	//	nearest query
+	double distance;
+
+	//	Latitude and longitude of the closest point to the query point on the 
+	//	track of each line in lines, in the order of their LineValues, after a
+	//	closest line query
+	std::vector< std::pair<double, double> > points;
+
+	//	Distance in kilometers from the query point to each of stations, after
+	//	a query that answers with a station for each line
+	std::vector<double> distances;
+
+	//	Lower bound on the distance in kilometers from the query point to 
+	//	anything that is not part of the answer of the last nearest query
+	double runner_up;
+
+	//	Buffer used to normalize station and line names before looking them up
+	std::string text;
+
+	//	Positions of the stations or entrances found by the last area query
+	std::vector<unsigned int> indices;
+
+	//	Positions of the entrances found by a query that finds stations in 
+	//	indices at the same time
+	std::vector<unsigned int> other_indices;
+
+	//	For each station of the last route, the lines of the ride that reaches
+	//	it, or 0 if it is reached on foot or is the first station
+	std::vector<unsigned long> route_lines;
+
+	//	Working storage for route searches: the best known travel time to each
+	//	node, the node each one was reached from, and the nodes waiting to be
+	//	visited with their estimated travel times
+	std::vector<double> costs;
+	std::vector<unsigned int> previous;
+	std::vector< std::pair<double, unsigned int> > queue;
+
+	//	The nodes of the stations within walking distance of the start and the
+	//	end of the last walking route, each paired with the minutes it takes to
+	//	walk between the station and that end
+	std::vector< std::pair<unsigned int, double> > origins;
+	std::vector< std::pair<unsigned int, double> > destinations;
+
+	//	Number of stations, entrances, graph nodes and index entries that the
+	//	queries given this QueryScratch object have examined since it was last
+	//	set to 0. Queries only add to it
+	unsigned long probes;
+
+	//	Constructor for QueryScratch object
+	QueryScratch() : stations(), entrances(), lines(0UL), distance(0), 
+	    points(), distances(), runner_up(0), text(), indices(), other_indices(),
+	    route_lines(), costs(), previous(), queue(), origins(), destinations(),
+	    probes(0)
+	{
+	}
+
+	//	Empties QueryScratch object without releasing its memory
+	void clear() {
+		stations.clear();
+		entrances.clear();
+		lines = 0UL;
+		distance = 0;
+		points.clear();
+		distances.clear();
+		runner_up = 0;
+		text.clear();
+		indices.clear();
+		other_indices.clear();
+		route_lines.clear();
+		queue.clear();
+		origins.clear();
+		destinations.clear();
+		probes = 0;
+	}
+};
+
+#endif
+
@@ -0,0 +1,143 @@
+/*******************************************************************************
+  Title          : query_stats.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the QueryStats class
+  Purpose        : To find out which kinds of commands take the most time, and
+									 how their latencies are spread
+  Usage          : Create a QueryStats object with one shard per thread, call
+									 record after each command and display at the end
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "query_stats.h"
+#include <algorithm>
+#include <iomanip>
+
+//	Adds value to counter, which only the calling thread writes
+static inline void add(std::atomic<uint64_t>& counter, uint64_t value) {
+	counter.store(counter.load(std::memory_order_relaxed) + value,
+								std::memory_order_relaxed);
+}
+
+QueryStats::QueryStats(const std::vector<std::string>& names,
+											 unsigned int shards) : names_(names), shards_()
+{
+	for (unsigned int i = 0; i < std::max(shards, 1U); ++i) {
+		shards_.push_back(std::unique_ptr<Shard>(new Shard(names.size())));
+	}
+}
+
+QueryStats::~QueryStats()
+{
+}
+
+void QueryStats::record(unsigned int shard, unsigned int kind,
+												uint64_t nanoseconds, uint64_t results,
+												uint64_t probes) {
+	Counters& c = shards_[shard]->kinds[kind];
+	add(c.count, 1);
+	add(c.nanoseconds, nanoseconds);
+	add(c.results, results);
+	add(c.probes, probes);
+	add(c.buckets[bucket(nanoseconds)], 1);
+	if (nanoseconds > c.longest.load(std::memory_order_relaxed)) {
+		c.longest.store(nanoseconds, std::memory_order_relaxed);
+	}
+}
+
+void QueryStats::display(std::ostream& out) const {
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+	out << std::left << std::setw(24) << "command" << std::right
+			<< std::setw(10) << "count" << std::setw(12) << "total ms"
+			<< std::setw(10) << "mean us" << std::setw(10) << "p50 us"
+			<< std::setw(10) << "p90 us" << std::setw(10) << "p99 us"
+			<< std::setw(10) << "max us" << std::setw(10) << "results"
+			<< std::setw(10) << "probes" << std::endl;
+	out << std::fixed;
+
+	std::vector<uint64_t> buckets(kBuckets);
+	for (unsigned int kind = 0; kind < names_.size(); ++kind) {
+		uint64_t count = 0, nanoseconds = 0, longest = 0, results = 0, probes = 0;
+		std::fill(buckets.begin(), buckets.end(), 0);
+		for (auto& shard : shards_) {
+			const Counters& c = shard->kinds[kind];
+			count += c.count.load(std::memory_order_relaxed);
+			nanoseconds += c.nanoseconds.load(std::memory_order_relaxed);
+			longest = std::max(longest, c.longest.load(std::memory_order_relaxed));
+			results += c.results.load(std::memory_order_relaxed);
+			probes += c.probes.load(std::memory_order_relaxed);
+			for (unsigned int b = 0; b < kBuckets; ++b) {
+				buckets[b] += c.buckets[b].load(std::memory_order_relaxed);
+			}
+		}
+		if (count == 0) {
+			continue;
+		}
+
+		//	a percentile is the largest value of the bucket that holds the
+		//	command of its rank, which is never more than the longest time
+		const double kPercentiles[3] = { 0.5, 0.9, 0.99 };
+		uint64_t values[3];
+		for (int p = 0; p < 3; ++p) {
+			uint64_t rank = (uint64_t)(kPercentiles[p] * count + 0.999999);
+			uint64_t seen = 0;
+			unsigned int b = 0;
+			while (b < kBuckets - 1 && seen + buckets[b] < rank) {
+				seen += buckets[b++];
+			}
+			values[p] = std::min(bucket_limit(b), longest);
+		}
+
+		out << std::left << std::setw(24) << names_[kind] << std::right
+				<< std::setw(10) << count << std::setprecision(3)
+				<< std::setw(12) << nanoseconds / 1e6 << std::setprecision(2)
+				<< std::setw(10) << nanoseconds / 1e3 / count
+				<< std::setw(10) << values[0] / 1e3
+				<< std::setw(10) << values[1] / 1e3
+				<< std::setw(10) << values[2] / 1e3
+				<< std::setw(10) << longest / 1e3 << std::setprecision(1)
+				<< std::setw(10) << (double)results / count
+				<< std::setw(10) << (double)probes / count << std::endl;
+	}
+	out.flags(flags);
+	out.precision(precision);
+}
+
+unsigned int QueryStats::shards() const {
+	return shards_.size();
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+QueryStats::Shard::Shard(unsigned int kinds) : kinds(kinds)
+{
+}
+
+unsigned int QueryStats::bucket(uint64_t value) {
+	if (value < 2 * kSubBuckets) {
+		return value;
+	}
+	//	the power of two of value picks the group of buckets, and the kSubBits
+	//	bits below its highest bit pick the bucket in the group
+	unsigned int power = 63 - __builtin_clzll(value);
+	return 2 * kSubBuckets + (power - kSubBits - 1) * kSubBuckets +
+				 ((value >> (power - kSubBits)) & (kSubBuckets - 1));
+}
+
+uint64_t QueryStats::bucket_limit(unsigned int bucket) {
+	if (bucket < 2 * kSubBuckets) {
+		return bucket;
+	}
+	unsigned int power = (bucket - 2 * kSubBuckets) / kSubBuckets + kSubBits + 1;
+	uint64_t sub = (bucket - 2 * kSubBuckets) % kSubBuckets;
+	uint64_t width = (uint64_t)1 << (power - kSubBits);
+	return ((kSubBuckets + sub) << (power - kSubBits)) + (width - 1);
+}
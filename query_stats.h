@@ -0,0 +1,117 @@
+/*******************************************************************************
+  Title          : query_stats.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the QueryStats class
+  Purpose        : To find out which kinds of commands take the most time, and
+									 how their latencies are spread
+  Usage          : Create a QueryStats object with one shard per thread, call
+									 record after each command and display at the end
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __QUERY_STATS_H__
+#define __QUERY_STATS_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+
+		The QueryStats class counts, for each kind of command, how many were run,
+		how many items their answers held, how many candidates the queries
+		examined to find them, and a histogram of how long they took.
+
+		The histogram is kept the way HDR histograms are: every power of two of
+		nanoseconds is split into kSubBuckets buckets of equal width, so every
+		latency is recorded with a relative error of at most 1 / kSubBuckets,
+		from one nanosecond to centuries, in a few hundred counters per kind of
+		command. Percentiles are read from the buckets.
+
+		The counters are split into shards, and each thread records into a shard
+		of its own, so recording takes no lock and no atomic read-modify-write
+		and threads never write to the same cache line. The counters are atomic
+		only so that display can read them while other threads are recording;
+		each is written by a single thread at a time, with plain loads and
+		stores.
+
+*******************************************************************************/
+
+class QueryStats {
+ public:
+	//	Creates a QueryStats object for kinds of commands named names, with
+	//	shards shards
+	QueryStats(const std::vector<std::string>& names, unsigned int shards);
+
+	//	Destroys QueryStats object
+	~QueryStats();
+
+	//	Records a command of kind kind that took nanoseconds nanoseconds, whose
+	//	answer held results items and that examined probes candidates. Only one
+	//	thread at a time may record into a shard
+	void record(unsigned int shard, unsigned int kind, uint64_t nanoseconds,
+							uint64_t results, uint64_t probes);
+
+	//	Displays a table with a row for each kind of command that has been
+	//	recorded: the number of commands, their total, mean, median, 90th and
+	//	99th percentile and longest times, and the mean number of results and
+	//	probes per command. Can be called while other threads record
+	void display(std::ostream& out) const;
+
+	//	Returns the number of shards
+	unsigned int shards() const;
+
+ private:
+	//	Number of buckets that each power of two is split into, as a power of 2
+	static const unsigned int kSubBits = 3;
+	static const unsigned int kSubBuckets = 1U << kSubBits;
+
+	//	Number of buckets of a histogram: one per value below 2 * kSubBuckets,
+	//	then kSubBuckets per power of two up to 2^63
+	static const unsigned int kBuckets = 2 * kSubBuckets +
+																			 (63 - kSubBits) * kSubBuckets;
+
+	//	The counters of one kind of command in one shard
+	struct Counters {
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> nanoseconds;
+		std::atomic<uint64_t> longest;
+		std::atomic<uint64_t> results;
+		std::atomic<uint64_t> probes;
+		std::atomic<uint64_t> buckets[kBuckets];
+	};
+
+	//	The counters of every kind of command written by one thread, padded so
+	//	that no two shards share a cache line
+	struct Shard {
+		char before[64];
+		std::vector<Counters> kinds;
+		char after[64];
+
+		explicit Shard(unsigned int kinds);
+	};
+
+	QueryStats(const QueryStats&);
+	QueryStats& operator=(const QueryStats&);
+
+	//	The name of each kind of command
+	std::vector<std::string> names_;
+
+	//	One shard per thread
+	std::vector< std::unique_ptr<Shard> > shards_;
+
+	//	Returns the bucket that value is counted in
+	static unsigned int bucket(uint64_t value);
+
+	//	Returns the largest value that is counted in bucket
+	static uint64_t bucket_limit(unsigned int bucket);
+};
+
+#endif
+
@@ -0,0 +1,612 @@
+/*******************************************************************************
+  Title          : route_graph.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the RouteGraph class
+  Purpose        : To find the fastest way to travel between two subway
+									 stations
+  Usage          : Build a RouteGraph object from a SubwaySystem object's
+									 stations and call shortest_path with the nodes of two
+									 stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "route_graph.h"
+#include "haversine.h"
+#include "hilbert_rtree.h"
+#include <algorithm>
+#include <functional>
+
+RouteGraph::RouteGraph() : stations_(), nodes_(), latitudes_(), longitudes_(),
+    lines_(), near_(), begins_(), ends_(), edges_(), unused_(0), rides_(),
+    members_(DEFAULT), line_stops_(DEFAULT), line_links_(DEFAULT)
+{
+}
+
+RouteGraph::~RouteGraph()
+{
+}
+
+void RouteGraph::build(const std::vector<const SubwayStation*>& stations) {
+	clear();
+	stations_ = stations;
+	unsigned int n = stations_.size();
+	latitudes_.resize(n);
+	longitudes_.resize(n);
+	lines_.resize(n);
+	for (unsigned int i = 0; i < n; ++i) {
+		stations_[i]->get_coordinates(latitudes_[i], longitudes_[i]);
+		lines_[i] = stations_[i]->get_identifier();
+		nodes_[stations_[i]] = i;
+		for (int line = A; line < DEFAULT; ++line) {
+			if (lines_[i] & (1UL << line)) {
+				members_[line].push_back(i);
+			}
+		}
+	}
+	near_.build(latitudes_, longitudes_);
+
+	//	merge the ride edges that join the same two nodes, such as the tracks
+	//	of lines that run together
+	std::vector< std::pair<unsigned int, Edge> > edges;
+	for (int line = A; line < DEFAULT; ++line) {
+		connect_line(line, edges);
+	}
+	std::sort(edges.begin(), edges.end(),
+		[](const std::pair<unsigned int, Edge>& a,
+			 const std::pair<unsigned int, Edge>& b) {
+			if (a.first != b.first) {
+				return a.first < b.first;
+			}
+			return a.second.target < b.second.target;
+		});
+	rides_.resize(n);
+	for (auto& e : edges) {
+		std::vector<Edge>& rides = rides_[e.first];
+		if (!rides.empty() && rides.back().target == e.second.target) {
+			rides.back().minutes = std::min(rides.back().minutes, e.second.minutes);
+			rides.back().lines |= e.second.lines;
+		} else {
+			rides.push_back(e.second);
+		}
+	}
+
+	begins_.assign(n, 0);
+	ends_.assign(n, 0);
+	std::vector<unsigned int> found;
+	std::vector<Edge> node_edges;
+	for (unsigned int i = 0; i < n; ++i) {
+		connect_node(i, found, node_edges);
+	}
+}
+
+unsigned long RouteGraph::update(
+		const std::vector<const SubwayStation*>& stations,
+		const std::vector<unsigned int>& changed, 
+		std::vector<unsigned int>& touched) {
+	unsigned int old_n = stations_.size();
+	unsigned int n = stations.size();
+	unsigned int most = std::max(old_n, n);
+	touched.clear();
+	stations_.resize(most, NULL);
+	latitudes_.resize(most, 0);
+	longitudes_.resize(most, 0);
+	lines_.resize(most, 0UL);
+	begins_.resize(most, 0);
+	ends_.resize(most, 0);
+	rides_.resize(most);
+	std::vector<bool> replaced(most, false);
+
+	//	take the old stations out, noting their lines and their neighbors, 
+	//	then put the new ones in. The lines of either must be connected again
+	unsigned long lines = 0UL;
+	for (auto& p : changed) {
+		replaced[p] = true;
+		touched.push_back(p);
+		if (p >= old_n) {
+			continue;
+		}
+		lines |= lines_[p];
+		for (const Edge* e = begin(p); e != end(p); ++e) {
+			touched.push_back(e->target);
+		}
+		nodes_.erase(stations_[p]);
+		near_.remove(p);
+		for (int line = A; line < DEFAULT; ++line) {
+			if (lines_[p] & (1UL << line)) {
+				std::vector<unsigned int>& members = members_[line];
+				members.erase(std::lower_bound(members.begin(), members.end(), p));
+			}
+		}
+		lines_[p] = 0UL;
+	}
+	for (auto& p : changed) {
+		if (p >= n) {
+			continue;
+		}
+		stations_[p] = stations[p];
+		stations_[p]->get_coordinates(latitudes_[p], longitudes_[p]);
+		lines_[p] = stations_[p]->get_identifier();
+		lines |= lines_[p];
+		nodes_[stations_[p]] = p;
+		near_.insert(p, latitudes_[p], longitudes_[p]);
+		for (int line = A; line < DEFAULT; ++line) {
+			if (lines_[p] & (1UL << line)) {
+				std::vector<unsigned int>& members = members_[line];
+				members.insert(std::lower_bound(members.begin(), members.end(), p),
+											 p);
+			}
+		}
+	}
+
+	//	a ride edge of a line that joins the same two unchanged nodes as 
+	//	before is taken out and put back the same, so only the nodes of the 
+	//	edges that came or went, and the changed nodes, are touched
+	std::vector< std::pair<unsigned int, Edge> > edges;
+	for (int line = A; line < DEFAULT; ++line) {
+		unsigned long mask = 1UL << line;
+		if (!(lines & mask)) {
+			continue;
+		}
+		std::vector< std::pair<unsigned int, unsigned int> > before;
+		for (unsigned int k = 1; k < line_stops_[line].size(); ++k) {
+			before.push_back(std::make_pair(line_stops_[line][k], 
+																			line_links_[line][k]));
+			before.push_back(std::make_pair(line_links_[line][k], 
+																			line_stops_[line][k]));
+		}
+		edges.clear();
+		connect_line(line, edges);
+		std::vector< std::pair<unsigned int, unsigned int> > after;
+		for (auto& e : edges) {
+			after.push_back(std::make_pair(e.first, e.second.target));
+		}
+		std::sort(before.begin(), before.end());
+		std::sort(after.begin(), after.end());
+
+		for (auto& b : before) {
+			std::vector<Edge>& rides = rides_[b.first];
+			for (unsigned int k = 0; k < rides.size(); ++k) {
+				if (rides[k].target == b.second) {
+					rides[k].lines &= ~mask;
+					if (rides[k].lines == 0UL) {
+						rides.erase(rides.begin() + k);
+					}
+					break;
+				}
+			}
+			if (!std::binary_search(after.begin(), after.end(), b)) {
+				touched.push_back(b.first);
+			}
+		}
+		for (auto& e : edges) {
+			std::vector<Edge>& rides = rides_[e.first];
+			unsigned int k = 0;
+			while (k < rides.size() && rides[k].target < e.second.target) {
+				++k;
+			}
+			if (k < rides.size() && rides[k].target == e.second.target) {
+				rides[k].minutes = e.second.minutes;
+				rides[k].lines |= mask;
+			} else {
+				rides.insert(rides.begin() + k, e.second);
+			}
+			std::pair<unsigned int, unsigned int> a(e.first, e.second.target);
+			if (!std::binary_search(before.begin(), before.end(), a)) {
+				touched.push_back(e.first);
+			}
+		}
+	}
+
+	//	the nodes within walking distance of the new stations gain edges to 
+	//	them, as the old stations' neighbors lose theirs
+	std::vector<unsigned int> found;
+	double min_lat, min_lon, max_lat, max_lon;
+	for (auto& p : changed) {
+		if (p < n) {
+			haversine_box(latitudes_[p], longitudes_[p], kTransferDistance, min_lat,
+										min_lon, max_lat, max_lon);
+			near_.search(min_lat, min_lon, max_lat, max_lon, found);
+			touched.insert(touched.end(), found.begin(), found.end());
+		}
+	}
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+	std::vector<Edge> node_edges;
+	for (auto& u : touched) {
+		if (u < n) {
+			connect_node(u, found, node_edges);
+		} else {
+			unused_ += ends_[u] - begins_[u];
+		}
+	}
+	stations_.resize(n);
+	latitudes_.resize(n);
+	longitudes_.resize(n);
+	lines_.resize(n);
+	begins_.resize(n);
+	ends_.resize(n);
+	rides_.resize(n);
+	if (unused_ > edges_.size() / 2) {
+		compact();
+	}
+	return lines;
+}
+
+void RouteGraph::relink(const std::vector<const SubwayStation*>& stations) {
+	nodes_.clear();
+	for (unsigned int i = 0; i < stations_.size() && i < stations.size(); ++i) {
+		stations_[i] = stations[i];
+		nodes_[stations_[i]] = i;
+	}
+}
+
+void RouteGraph::clear() {
+	stations_.clear();
+	nodes_.clear();
+	latitudes_.clear();
+	longitudes_.clear();
+	lines_.clear();
+	near_.build(latitudes_, longitudes_);
+	begins_.clear();
+	ends_.clear();
+	edges_.clear();
+	unused_ = 0;
+	rides_.clear();
+	members_.assign(DEFAULT, std::vector<unsigned int>());
+	line_stops_.assign(DEFAULT, std::vector<unsigned int>());
+	line_links_.assign(DEFAULT, std::vector<unsigned int>());
+}
+
+int RouteGraph::node(const SubwayStation* station) const {
+	auto found = nodes_.find(station);
+	return (found != nodes_.end()) ? (int)found->second : -1;
+}
+
+const SubwayStation* RouteGraph::station(unsigned int node) const {
+	return stations_[node];
+}
+
+unsigned int RouteGraph::nodes() const {
+	return stations_.size();
+}
+
+unsigned int RouteGraph::edges() const {
+	return edges_.size() - unused_;
+}
+
+const RouteGraph::Edge* RouteGraph::begin(unsigned int node) const {
+	return edges_.data() + begins_[node];
+}
+
+const RouteGraph::Edge* RouteGraph::end(unsigned int node) const {
+	return edges_.data() + ends_[node];
+}
+
+const std::vector<unsigned int>& RouteGraph::line_stops(int line) const {
+	return line_stops_[line];
+}
+
+const std::vector<unsigned int>& RouteGraph::line_links(int line) const {
+	return line_links_[line];
+}
+
+bool RouteGraph::shortest_path(unsigned int from, unsigned int to,
+															 QueryScratch& scratch, bool guided) const {
+	std::vector<double>& costs = scratch.costs;
+	std::vector<unsigned int>& previous = scratch.previous;
+	std::vector< std::pair<double, unsigned int> >& queue = scratch.queue;
+	std::greater< std::pair<double, unsigned int> > later;
+	costs.assign(stations_.size(), HUGE_VAL);
+	previous.assign(stations_.size(), from);
+	queue.clear();
+	scratch.stations.clear();
+	scratch.route_lines.clear();
+	scratch.distance = HUGE_VAL;
+
+	//	without a lower bound, A* is Dijkstra's algorithm
+	costs[from] = 0;
+	queue.push_back(std::make_pair(guided ? lower_bound(from, to) : 0, from));
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), later);
+		std::pair<double, unsigned int> next = queue.back();
+		queue.pop_back();
+		unsigned int u = next.second;
+		if (u == to) {
+			scratch.distance = costs[to];
+			trace_path(to, scratch);
+			return true;
+		}
+		if (costs[u] + (guided ? lower_bound(u, to) : 0) < next.first) {
+			//	u was reached faster after this entry was queued
+			continue;
+		}
+		++scratch.probes;
+		for (const Edge* e = begin(u); e != end(u); ++e) {
+			double cost = costs[u] + e->minutes;
+			if (cost < costs[e->target]) {
+				costs[e->target] = cost;
+				previous[e->target] = u;
+				double bound = guided ? lower_bound(e->target, to) : 0;
+				queue.push_back(std::make_pair(cost + bound, e->target));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+		}
+	}
+	return false;
+}
+
+bool RouteGraph::shortest_path(
+		const std::vector< std::pair<unsigned int, double> >& sources,
+		const std::vector< std::pair<unsigned int, double> >& targets,
+		QueryScratch& scratch) const {
+	std::vector<double>& costs = scratch.costs;
+	std::vector<unsigned int>& previous = scratch.previous;
+	std::vector< std::pair<double, unsigned int> >& queue = scratch.queue;
+	std::greater< std::pair<double, unsigned int> > later;
+	costs.assign(stations_.size(), HUGE_VAL);
+	previous.resize(stations_.size());
+	queue.clear();
+	scratch.stations.clear();
+	scratch.route_lines.clear();
+	scratch.distance = HUGE_VAL;
+
+	//	Dijkstra's algorithm, started from every source at once with the minutes
+	//	it takes to reach it, stops once nothing left to visit can beat the 
+	//	fastest way found to leave through a target
+	for (auto& s : sources) {
+		if (s.second < costs[s.first]) {
+			costs[s.first] = s.second;
+			previous[s.first] = s.first;
+			queue.push_back(std::make_pair(s.second, s.first));
+		}
+	}
+	std::make_heap(queue.begin(), queue.end(), later);
+	double best = HUGE_VAL;
+	unsigned int last = stations_.size();
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), later);
+		std::pair<double, unsigned int> next = queue.back();
+		queue.pop_back();
+		if (next.first >= best) {
+			break;
+		}
+		unsigned int u = next.second;
+		if (next.first > costs[u]) {
+			continue;
+		}
+		++scratch.probes;
+		auto target = std::lower_bound(targets.begin(), targets.end(),
+																	 std::make_pair(u, -HUGE_VAL));
+		if (target != targets.end() && target->first == u &&
+				next.first + target->second < best) {
+			best = next.first + target->second;
+			last = u;
+		}
+		for (const Edge* e = begin(u); e != end(u); ++e) {
+			double cost = costs[u] + e->minutes;
+			if (cost < costs[e->target]) {
+				costs[e->target] = cost;
+				previous[e->target] = u;
+				queue.push_back(std::make_pair(cost, e->target));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+		}
+	}
+	if (last == stations_.size()) {
+		return false;
+	}
+	scratch.distance = best;
+	trace_path(last, scratch);
+	return true;
+}
+
+double RouteGraph::lower_bound(unsigned int from, unsigned int to) const {
+	return haversine(latitudes_[from], longitudes_[from], latitudes_[to],
+									 longitudes_[to]) / kRideSpeed;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void RouteGraph::connect_line(int line,
+								std::vector< std::pair<unsigned int, Edge> >& edges) {
+	unsigned long mask = 1UL << line;
+	const std::vector<unsigned int>& members = members_[line];
+	std::vector<unsigned int>& stops = line_stops_[line];
+	std::vector<unsigned int>& links = line_links_[line];
+	stops.clear();
+	links.clear();
+	unsigned int k = members.size();
+	if (k == 0) {
+		return;
+	}
+
+	//	Prim's algorithm; the stations of a line are few enough that comparing
+	//	every pair is faster than anything cleverer
+	std::vector<bool> in_tree(k, false);
+	std::vector<double> closest(k, HUGE_VAL);
+	std::vector<unsigned int> parent(k, 0);
+	std::vector< std::vector<unsigned int> > tree(k);
+	closest[0] = 0;
+	for (unsigned int added = 0; added < k; ++added) {
+		unsigned int next = k;
+		for (unsigned int i = 0; i < k; ++i) {
+			if (!in_tree[i] && (next == k || closest[i] < closest[next])) {
+				next = i;
+			}
+		}
+		in_tree[next] = true;
+		if (added > 0) {
+			tree[next].push_back(parent[next]);
+			tree[parent[next]].push_back(next);
+			unsigned int a = members[next], b = members[parent[next]];
+			Edge ride = { b, closest[next] / kRideSpeed, mask };
+			edges.push_back(std::make_pair(a, ride));
+			ride.target = a;
+			edges.push_back(std::make_pair(b, ride));
+		}
+		for (unsigned int i = 0; i < k; ++i) {
+			if (!in_tree[i]) {
+				double distance = haversine(latitudes_[members[next]],
+																		longitudes_[members[next]],
+																		latitudes_[members[i]],
+																		longitudes_[members[i]]);
+				if (distance < closest[i]) {
+					closest[i] = distance;
+					parent[i] = next;
+				}
+			}
+		}
+	}
+
+	//	the ends of the line are the two stations that are farthest apart along
+	//	the tree; from[i] is the station before i on the way from start
+	std::vector<double> along(k);
+	std::vector<unsigned int> from(k);
+	auto walk_tree = [&](unsigned int start) {
+		std::vector<unsigned int> stack(1, start);
+		along.assign(k, -1);
+		along[start] = 0;
+		from[start] = start;
+		unsigned int farthest = start;
+		while (!stack.empty()) {
+			unsigned int u = stack.back();
+			stack.pop_back();
+			if (along[u] > along[farthest]) {
+				farthest = u;
+			}
+			for (auto& v : tree[u]) {
+				if (along[v] < 0) {
+					along[v] = along[u] + haversine(latitudes_[members[u]],
+																					longitudes_[members[u]],
+																					latitudes_[members[v]],
+																					longitudes_[members[v]]);
+					from[v] = u;
+					stack.push_back(v);
+				}
+			}
+		}
+		return farthest;
+	};
+	unsigned int first = walk_tree(0);
+	unsigned int last = walk_tree(first);
+	std::vector<bool> trunk(k, false);
+	for (unsigned int u = last; u != first; u = from[u]) {
+		trunk[u] = true;
+	}
+	trunk[first] = true;
+
+	//	list the stations from the first end, finishing each branch before
+	//	continuing along the trunk; walk_tree(first) left the station before
+	//	each one in from
+	std::vector<unsigned int> stack(1, first);
+	std::vector<bool> listed(k, false);
+	while (!stack.empty()) {
+		unsigned int u = stack.back();
+		stack.pop_back();
+		listed[u] = true;
+		stops.push_back(members[u]);
+		links.push_back(members[from[u]]);
+		for (auto& v : tree[u]) {
+			if (!listed[v] && trunk[v]) {
+				stack.push_back(v);
+			}
+		}
+		for (auto& v : tree[u]) {
+			if (!listed[v] && !trunk[v]) {
+				stack.push_back(v);
+			}
+		}
+	}
+}
+
+void RouteGraph::connect_node(unsigned int node, 
+															std::vector<unsigned int>& found,
+															std::vector<Edge>& edges) {
+	//	the walking distance is measured from the lower node, as it is for the
+	//	edge in the other direction
+	edges.clear();
+	double min_lat, min_lon, max_lat, max_lon;
+	haversine_box(latitudes_[node], longitudes_[node], kTransferDistance, 
+								min_lat, min_lon, max_lat, max_lon);
+	near_.search(min_lat, min_lon, max_lat, max_lon, found);
+	std::vector<Edge>::iterator ride = rides_[node].begin();
+	for (auto& j : found) {
+		if (j == node) {
+			continue;
+		}
+		unsigned int a = std::min(node, j), b = std::max(node, j);
+		double distance = haversine(latitudes_[a], longitudes_[a], latitudes_[b],
+																longitudes_[b]);
+		if (distance > kTransferDistance) {
+			continue;
+		}
+		while (ride != rides_[node].end() && ride->target < j) {
+			edges.push_back(*ride++);
+		}
+		Edge walk = { j, distance / kWalkSpeed, 0UL };
+		if (ride != rides_[node].end() && ride->target == j) {
+			walk.minutes = std::min(walk.minutes, ride->minutes);
+			walk.lines = ride->lines;
+			++ride;
+		}
+		edges.push_back(walk);
+	}
+	edges.insert(edges.end(), ride, rides_[node].end());
+
+	unsigned int size = ends_[node] - begins_[node];
+	if (edges.size() > size) {
+		unused_ += size;
+		begins_[node] = edges_.size();
+		edges_.insert(edges_.end(), edges.begin(), edges.end());
+	} else {
+		unused_ += size - edges.size();
+		std::copy(edges.begin(), edges.end(), edges_.begin() + begins_[node]);
+	}
+	ends_[node] = begins_[node] + edges.size();
+}
+
+void RouteGraph::compact() {
+	std::vector<Edge> edges;
+	edges.reserve(edges_.size() - unused_);
+	for (unsigned int u = 0; u < begins_.size(); ++u) {
+		unsigned int first = edges.size();
+		edges.insert(edges.end(), edges_.begin() + begins_[u], 
+								 edges_.begin() + ends_[u]);
+		begins_[u] = first;
+		ends_[u] = edges.size();
+	}
+	edges_.swap(edges);
+	unused_ = 0;
+}
+
+void RouteGraph::trace_path(unsigned int to, QueryScratch& scratch) const {
+	unsigned int u = to;
+	while (true) {
+		scratch.stations.push_back(stations_[u]);
+		unsigned int p = scratch.previous[u];
+		if (p == u) {
+			scratch.route_lines.push_back(0UL);
+			break;
+		}
+		//	the lines of the edge that the search took from p to u
+		unsigned long lines = 0UL;
+		for (const Edge* e = begin(p); e != end(p); ++e) {
+			if (e->target == u) {
+				lines = e->lines;
+				break;
+			}
+		}
+		scratch.route_lines.push_back(lines);
+		u = p;
+	}
+	std::reverse(scratch.stations.begin(), scratch.stations.end());
+	std::reverse(scratch.route_lines.begin(), scratch.route_lines.end());
+}
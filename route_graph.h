@@ -0,0 +1,228 @@
+/*******************************************************************************
+  Title          : route_graph.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the RouteGraph class
+  Purpose        : To find the fastest way to travel between two subway
+									 stations
+  Usage          : Build a RouteGraph object from a SubwaySystem object's
+									 stations and call shortest_path with the nodes of two
+									 stations
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __ROUTE_GRAPH_H__
+#define __ROUTE_GRAPH_H__
+
+#include <unordered_map>
+#include <vector>
+#include "subway_entrance.h"
+#include "subway_station.h"
+#include "query_scratch.h"
+#include "hilbert_rtree.h"
+
+//	Average speed of a train, in kilometers per minute (30 km/h)
+const double kRideSpeed = 0.5;
+
+//	Average walking speed, in kilometers per minute (5 km/h)
+const double kWalkSpeed = 5.0 / 60;
+
+//	Farthest distance in kilometers between two stations that a rider will
+//	walk to transfer between them
+const double kTransferDistance = 0.3;
+
+//	Farthest distance in kilometers that a rider will walk between a point and
+//	a subway entrance at either end of a route
+const double kWalkingRadius = 1.0;
+
+/*******************************************************************************
+
+		The RouteGraph class is a graph of the subway system that is used to find
+		the fastest route between two stations. Every station is a node, and nodes
+		are numbered in the order of the stations that the graph was built from.
+
+		The data set does not say in which order a train line stops at its
+		stations, so the order is derived from where the stations are. The
+		stations of a line are joined by the shortest set of tracks that connects
+		all of them, which is the minimum spanning tree of the stations with
+		haversine distances as weights. Like a real subway line, such a tree can
+		branch, and two stations are next to each other on the line if the tree
+		joins them. Each joined pair is a ride edge of the graph. Two different
+		stations that are at most kTransferDistance apart are joined by a walking
+		edge, which is how riders transfer between lines that do not share a
+		station; the stations near each one are found in a HilbertRTree. Lines
+		that share a station can be transferred between for free.
+
+		The weight of an edge is the number of minutes it takes to travel it:
+		its haversine length divided by kRideSpeed or kWalkSpeed. Since nothing is
+		faster than a train, the haversine distance to the destination divided by
+		kRideSpeed never overestimates the remaining travel time, so shortest_path
+		can use it to search with A*. The edges are stored in compressed sparse
+		row form: the edges leaving a node are next to each other in one vector,
+		so a search reads memory in order and never allocates. A built RouteGraph
+		is never modified by a search, so any number of threads can search it at
+		the same time, as long as each thread uses its own QueryScratch object.
+
+		When some of the stations change, update only connects the lines that
+		stop at the old or the new stations again, and only the edges of the 
+		nodes that a changed ride edge or walking edge leaves are made again. 
+		The ride edges of each node are kept apart from its walking edges for
+		that, and the HilbertRTree of the nodes is updated in place. A node's
+		new edges are written over its old ones if they fit, or after the last
+		node's otherwise, and the vector is compacted once more than half of it
+		is no longer used.
+
+*******************************************************************************/
+
+class RouteGraph {
+ public:
+	//	An edge leaving a node
+	struct Edge {
+		//	The node that the edge leads to
+		unsigned int target;
+
+		//	The number of minutes it takes to travel the edge
+		double minutes;
+
+		//	32-bit mask of the lines that ride the edge, or 0 for a walking edge
+		unsigned long lines;
+	};
+
+	//	Creates an empty RouteGraph object
+	RouteGraph();
+
+	//	Destroys RouteGraph object
+	~RouteGraph();
+
+	//	Builds the graph of stations, replacing the previous graph, if any. The
+	//	stations must exist for as long as the graph is used
+	void build(const std::vector<const SubwayStation*>& stations);
+
+	//	Brings the graph up to date with stations after the stations at the 
+	//	positions in changed have been replaced, added or removed, and sets 
+	//	touched to the nodes whose edges may have changed, including the 
+	//	removed ones. A position in changed that is not less than the size of
+	//	stations was removed, and every position from the size of stations to
+	//	the number of nodes must be in changed. The positions of the other 
+	//	stations must not have changed. Returns the 32-bit mask of the lines 
+	//	that stop at an old or a new station, whose tracks may have changed
+	unsigned long update(const std::vector<const SubwayStation*>& stations,
+											 const std::vector<unsigned int>& changed,
+											 std::vector<unsigned int>& touched);
+
+	//	Points the graph at stations after the stations it holds have moved to 
+	//	other addresses. The stations at positions that are not less than the 
+	//	size of stations are left for the next update to remove
+	void relink(const std::vector<const SubwayStation*>& stations);
+
+	//	Removes every node and edge from RouteGraph object
+	void clear();
+
+	//	Returns the node of station, or -1 if station is not in the graph
+	int node(const SubwayStation* station) const;
+
+	//	Returns the station of node
+	const SubwayStation* station(unsigned int node) const;
+
+	//	Returns the number of nodes
+	unsigned int nodes() const;
+
+	//	Returns the number of edges, counting each direction separately
+	unsigned int edges() const;
+
+	//	Return the first edge leaving node and the position after its last edge
+	const Edge* begin(unsigned int node) const;
+	const Edge* end(unsigned int node) const;
+
+	//	Returns the nodes of the stations that line, a LineValue, stops at,
+	//	starting at one end of the line. Where the line branches, the stations of
+	//	a branch are listed before the line continues
+	const std::vector<unsigned int>& line_stops(int line) const;
+
+	//	Returns, for each stop in line_stops(line), the node of the stop that 
+	//	comes before it on the way from the first stop, which is the first stop
+	//	itself for the first stop. Each stop and the stop before it are joined
+	//	by a ride edge of line
+	const std::vector<unsigned int>& line_links(int line) const;
+
+	//	Finds the fastest route from node from to node to. Sets scratch.stations
+	//	to the stations along the route, scratch.route_lines to the lines of the
+	//	edge that leads to each of those stations (0 for the first station and
+	//	for walking) and scratch.distance to the travel time in minutes. Returns
+	//	false, with scratch.stations empty, if there is no route. If guided is
+	//	false, the search is plain Dijkstra's algorithm instead of A*, which
+	//	finds the same travel time but visits more nodes. Adds the number of
+	//	nodes visited to scratch.probes
+	bool shortest_path(unsigned int from, unsigned int to,
+										 QueryScratch& scratch, bool guided = true) const;
+
+	//	Finds the fastest route that starts at any of the nodes in sources and
+	//	ends at any of the nodes in targets. Each node is paired with the 
+	//	minutes it takes to reach it before the route starts, or to leave it 
+	//	after the route ends, and those minutes are part of the travel time.
+	//	targets must be sorted by node. Sets scratch the same way as the other
+	//	shortest_path does, with scratch.distance including the minutes of both
+	//	ends
+	bool shortest_path(
+			const std::vector< std::pair<unsigned int, double> >& sources,
+			const std::vector< std::pair<unsigned int, double> >& targets,
+			QueryScratch& scratch) const;
+
+	//	Returns a lower bound on the number of minutes it takes to travel from
+	//	node from to node to
+	double lower_bound(unsigned int from, unsigned int to) const;
+
+ private:
+	//	The station of each node, and the node of each station
+	std::vector<const SubwayStation*> stations_;
+	std::unordered_map<const SubwayStation*, unsigned int> nodes_;
+
+	//	The coordinates of each node's station, and the mask of its lines
+	std::vector<double> latitudes_;
+	std::vector<double> longitudes_;
+	std::vector<unsigned long> lines_;
+
+	//	Index of the nodes by their coordinates
+	HilbertRTree near_;
+
+	//	The edges leaving node n are edges_[begins_[n]] to edges_[ends_[n] - 1],
+	//	sorted by target. unused_ entries of edges_ are no node's
+	std::vector<unsigned int> begins_;
+	std::vector<unsigned int> ends_;
+	std::vector<Edge> edges_;
+	unsigned int unused_;
+
+	//	The ride edges leaving each node, sorted by target
+	std::vector< std::vector<Edge> > rides_;
+
+	//	The nodes that each line stops at in increasing order, its stops, and 
+	//	the stop before each of them, indexed by LineValue
+	std::vector< std::vector<unsigned int> > members_;
+	std::vector< std::vector<unsigned int> > line_stops_;
+	std::vector< std::vector<unsigned int> > line_links_;
+
+	//	Joins the stations of line with the edges of their minimum spanning tree
+	//	and sets the line's stops and links. Adds one Edge per direction to 
+	//	edges, paired with the node the edge leaves
+	void connect_line(int line,
+										std::vector< std::pair<unsigned int, Edge> >& edges);
+
+	//	Sets the edges leaving node to its ride edges merged with walking edges
+	//	to every other node within kTransferDistance. found is used for the 
+	//	nodes near it and edges for its edges
+	void connect_node(unsigned int node, std::vector<unsigned int>& found,
+										std::vector<Edge>& edges);
+
+	//	Moves the edges of every node next to each other again, in the order 
+	//	of the nodes
+	void compact();
+
+	//	Sets scratch.stations and scratch.route_lines to the route found by the
+	//	last search, which ended at node to
+	void trace_path(unsigned int to, QueryScratch& scratch) const;
+};
+
+#endif
+
@@ -0,0 +1,66 @@
+/*******************************************************************************
+  Title          : string_hash.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the hash function of station 
+									 and line names
+  Purpose        : To spread the names of stations and lines evenly over the 
+									 slots of their hash tables
+  Usage          : Call hash_string with a name, and reduce the result modulo 
+									 the capacity of the table
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "string_hash.h"
+#include <string.h>
+
+//	Odd constants with about as many one bits as zero bits, from wyhash
+static const uint64_t kSecret0 = 0xa0761d6478bd642fULL;
+static const uint64_t kSecret1 = 0xe7037ed1a0b428dbULL;
+static const uint64_t kSecret2 = 0x8ebc6af09c88c6e3ULL;
+
+//	Returns the exclusive or of the two halves of the 128-bit product of a 
+//	and b
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+	__uint128_t product = (__uint128_t)a * b;
+	return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+//	Returns the count (at most 8) bytes at p as a little-endian word, with
+//	every ASCII uppercase letter made lowercase if fold_case is true
+static inline uint64_t read(const char* p, unsigned int count, bool fold_case) {
+	uint64_t word = 0;
+	memcpy(&word, p, count);
+	if (fold_case) {
+		//	a byte below 0x80 is a letter from A to Z if adding 0x3f to it sets
+		//	its high bit and adding 0x25 does not, and setting bit 5 of such a
+		//	byte makes it lowercase
+		const uint64_t kHigh = 0x8080808080808080ULL;
+		uint64_t low = word & ~kHigh;
+		uint64_t upper = ((low + 0x3f3f3f3f3f3f3f3fULL) ^ 
+											(low + 0x2525252525252525ULL)) & ~word & kHigh;
+		word |= upper >> 2;
+	}
+	return word;
+}
+
+uint64_t hash_string(const std::string& text, bool fold_case) {
+	const char* p = text.data();
+	size_t length = text.length();
+	uint64_t seed = kSecret0 ^ length;
+	for (; length > 16; length -= 16, p += 16) {
+		seed = mix(read(p, 8, fold_case) ^ kSecret1, 
+							 read(p + 8, 8, fold_case) ^ seed);
+	}
+	uint64_t a, b = 0;
+	if (length > 8) {
+		a = read(p, 8, fold_case);
+		b = read(p + 8, length - 8, fold_case);
+	} else {
+		a = read(p, length, fold_case);
+	}
+	return mix(kSecret1 ^ text.length(), 
+						 mix(a ^ kSecret1, b ^ seed) ^ kSecret2);
+}
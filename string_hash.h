@@ -0,0 +1,32 @@
+/*******************************************************************************
+  Title          : string_hash.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the hash function of station and 
+									 line names
+  Purpose        : To spread the names of stations and lines evenly over the 
+									 slots of their hash tables
+  Usage          : Call hash_string with a name, and reduce the result modulo 
+									 the capacity of the table
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __STRING_HASH_H__
+#define __STRING_HASH_H__
+
+#include <stdint.h>
+#include <string>
+
+//	Returns a 64-bit hash of text, or of the lowercase form of text if 
+//	fold_case is true, in the style of wyhash: text is read 16 bytes at a 
+//	time, and each block is mixed into the hash by multiplying two 64-bit 
+//	words into 128 bits and folding the halves together with exclusive or. 
+//	Every byte of text changes every bit of the hash, so names that differ in
+//	one character, such as two corners of the same street, do not cluster. 
+//	Case is folded eight bytes at a time and only for ASCII letters, like 
+//	tolower in the C locale
+uint64_t hash_string(const std::string& text, bool fold_case = false);
+
+#endif
@@ -55,6 +55,10 @@ Entrance& Entrance::operator=(const Entrance& other_entrance) {
 	return *this;
 }
 
+int Entrance::get_id() const {
+	return id_;
+}
+
 unsigned long Entrance::get_identifier() const {
 	return line_identifier_;
 }
@@ -66,7 +70,7 @@ void Entrance::get_coordinates(double& lat, double& lon) const {
 }
 
 	
-std::string Entrance::get_entrance_name() const {
+const std::string& Entrance::get_entrance_name() const {
 	return name_;
 }
 
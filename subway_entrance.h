@@ -107,6 +107,9 @@ class Entrance {
 	//	other_entrance
 	Entrance& operator=(const Entrance& other_entrance);
 
+	//	Returns Entrance object's id_ member
+	int get_id() const;
+
 	//	Returns Entrance object's line_identifier_ member
 	unsigned long get_identifier() const;
 
@@ -114,8 +117,8 @@ class Entrance {
 	//	sets lon equal to Entrance object's longitude_ member
 	void get_coordinates(double& lat, double& lon) const;
 
-	//	Returns Entrance object's name_ member
-	std::string get_entrance_name() const;
+	//	Returns an unmodifiable reference to Entrance object's name_ member
+	const std::string& get_entrance_name() const;
 
 	//	Returns true if Entrance object's line_identifier_ member is equal to
 	//	other_line. Returns false otherwise
@@ -0,0 +1,242 @@
+/*******************************************************************************
+  Title          : subway_file.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for reading the NYC subway 
+									 entrances file
+  Purpose        : To read the entrances of New York City's subway system into
+									 a SubwaySystem object
+  Usage          : Call read_subway_file with the path of the entrances file
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "subway_file.h"
+#include "trace.h"
+#include "alloc_stats.h"
+#include "work_pool.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//	Fewest bytes of the subway file that a thread is given to parse
+static const unsigned long kSmallestChunk = 65536;
+
+//	The text of a file, mapped into memory if it can be, or else read into
+//	buffer
+struct FileText {
+	const char* text;
+	unsigned long size;
+	bool mapped;
+	std::vector<char> buffer;
+
+	FileText() : text(NULL), size(0), mapped(false), buffer() {}
+	~FileText() {
+		if (mapped) {
+			munmap((void*)text, size);
+		}
+	}
+};
+
+//	Fills file with the text of the file at path. Returns false if it cannot
+//	be opened or read
+static bool read_text(const char* path, FileText& file) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+		void* text = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (text != MAP_FAILED) {
+			file.text = (const char*)text;
+			file.size = info.st_size;
+			file.mapped = true;
+			close(fd);
+			return true;
+		}
+	}
+
+	//	pipes and empty files cannot be mapped, so they are read instead
+	char block[65536];
+	ssize_t count;
+	while ((count = read(fd, block, sizeof(block))) > 0) {
+		file.buffer.insert(file.buffer.end(), block, block + count);
+	}
+	close(fd);
+	if (count < 0) {
+		return false;
+	}
+	file.text = file.buffer.data();
+	file.size = file.buffer.size();
+	return true;
+}
+
+//	Returns the position of the first line of text that starts at or after 
+//	pos, or size if there is none
+static unsigned long line_start(const char* text, unsigned long size,
+																unsigned long pos) {
+	if (pos == 0) {
+		return 0;
+	}
+	const char* newline = (const char*)memchr(text + pos - 1, '\n', 
+																						 size - pos + 1);
+	return newline ? newline - text + 1 : size;
+}
+
+//	Returns the entrance on a_line, a line of the subway file
+static Entrance parse_entrance(const std::string& a_line) {
+	int entrance_id = 0;
+	double latitude = 0, longitude = 0;
+	std::string website, name, data;
+	std::vector<std::string> train_lines;
+
+	unsigned int start = 0, count = 1;
+	for (unsigned int i = 0; i < a_line.length(); ++i) {
+		if (a_line[i] == ',') {
+			data = a_line.substr(start, i - start);
+			if (count != 3) {
+				std::istringstream ss1(data);
+				if (1 == count) {
+					ss1 >> entrance_id;
+				} else if (2 == count) {
+					ss1 >> website;
+				} else if (4 == count) {
+					unsigned int begin = 7;
+					for (unsigned int j = 7; j < data.length(); ++j) {
+						if (data[j] == ' ') {
+							std::istringstream ss2(data.substr(begin, j - begin));
+							ss2 >> longitude;
+							begin = j + 1;
+						} else if (j == data.length() - 1) {
+							std::istringstream ss2(data.substr(begin));
+							ss2 >> latitude;
+						}
+					}
+				}
+			} else {
+				name = data;
+			}
+			start = i + 1;
+			++count;
+		} else if (i == a_line.length() - 1) {
+			data = a_line.substr(start);
+			if (data.length() == 1 || data == "SIR" || data == "FS") {
+				train_lines.push_back(data);
+			} else {
+				unsigned int begin = 0;
+				for (unsigned int k = 0; k < data.length(); ++k) {
+					if (data[k] == '-') {
+						train_lines.push_back(data.substr(begin, k - begin));
+						begin = k + 1;
+					} else if (k == data.length() - 1) {
+						train_lines.push_back(data.substr(begin));
+					}
+				}
+			}
+		}
+	}
+
+	return Entrance(entrance_id, website, name, latitude, longitude, 
+									train_lines);
+}
+
+bool read_subway_file(const char* path, SubwaySystem& subway_system,
+											unsigned int threads) {
+	std::vector<Entrance> entrances;
+	if (!read_subway_file(path, entrances, threads)) {
+		return false;
+	}
+	TRACE_SPAN("add_entrances");
+	ALLOC_SCOPE("add_entrances");
+	subway_system.add(entrances, threads);
+	return true;
+}
+
+bool read_subway_file(const char* path, std::vector<Entrance>& entrances,
+											unsigned int threads) {
+	TRACE_SPAN("parse_subway_file", path);
+	ALLOC_SCOPE("parse_subway_file");
+	entrances.clear();
+	FileText file;
+	if (!read_text(path, file)) {
+		return false;
+	}
+
+	//	each chunk holds the lines that start in an equal share of the text, 
+	//	and is parsed into a vector of its own so that the entrances can be put
+	//	back in the order of the file
+	WorkPool pool(threads);
+	unsigned long chunks = std::min(4UL * pool.size(), 
+																	file.size / kSmallestChunk + 1);
+	std::vector< std::vector<Entrance> > parsed(chunks);
+	pool.parallel_for(0, chunks, 1, [&](unsigned int, unsigned int first,
+																			unsigned int last) {
+		for (unsigned int k = first; k < last; ++k) {
+			TRACE_SPAN("parse_chunk");
+			unsigned long pos = line_start(file.text, file.size,
+																		 file.size * k / chunks);
+			unsigned long end = line_start(file.text, file.size,
+																		 file.size * (k + 1) / chunks);
+			while (pos < end) {
+				const char* newline = (const char*)memchr(file.text + pos, '\n',
+																									file.size - pos);
+				if (!newline) {
+					//	a last line without a newline is not an entrance
+					break;
+				}
+				unsigned long length = newline - file.text - pos;
+				parsed[k].push_back(parse_entrance(std::string(file.text + pos,
+																											 length)));
+				pos += length + 1;
+			}
+		}
+	});
+
+	unsigned long count = 0;
+	for (auto& chunk : parsed) {
+		count += chunk.size();
+	}
+	entrances.reserve(count);
+	for (auto& chunk : parsed) {
+		entrances.insert(entrances.end(), std::make_move_iterator(chunk.begin()),
+										 std::make_move_iterator(chunk.end()));
+	}
+	return true;
+}
+
+bool read_delta_file(const char* path, std::vector<Entrance>& adds,
+										 std::vector<int>& removes) {
+	TRACE_SPAN("parse_delta_file", path);
+	ALLOC_SCOPE("parse_delta_file");
+	adds.clear();
+	removes.clear();
+	std::ifstream delta_file;
+	delta_file.open(path);
+	if (delta_file.fail()) {
+		return false;
+	}
+
+	std::string a_line;
+	while (std::getline(delta_file, a_line)) {
+		if (a_line.empty()) {
+			continue;
+		}
+		if (a_line[0] == '-') {
+			removes.push_back(strtol(a_line.c_str() + 1, NULL, 10));
+		} else {
+			adds.push_back(parse_entrance(a_line));
+		}
+	}
+	return true;
+}
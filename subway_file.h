@@ -0,0 +1,46 @@
+/*******************************************************************************
+  Title          : subway_file.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for reading the NYC subway entrances file
+  Purpose        : To read the entrances of New York City's subway system into
+									 a SubwaySystem object
+  Usage          : Call read_subway_file with the path of the entrances file
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __SUBWAY_FILE_H__
+#define __SUBWAY_FILE_H__
+
+#include <vector>
+#include "subway_entrance.h"
+#include "subway_system.h"
+
+//	Adds every entrance in the csv file at path, which has one entrance on each
+//	line from the NYC OpenData project, to subway_system, reading the file and
+//	grouping the entrances into stations on threads threads (one per hardware
+//	thread if threads is 0). make_subway_system must still be called 
+//	afterwards. Returns false if the file cannot be opened
+bool read_subway_file(const char* path, SubwaySystem& subway_system,
+											unsigned int threads = 1);
+
+//	Replaces the contents of entrances with every entrance in the csv file at 
+//	path, in the order of the file. The file is split into chunks that begin
+//	and end at line breaks, which are parsed on threads threads (one per 
+//	hardware thread if threads is 0). Returns false if the file cannot be 
+//	opened
+bool read_subway_file(const char* path, std::vector<Entrance>& entrances,
+											unsigned int threads = 1);
+
+//	Replaces the contents of adds and removes with the changes in the delta 
+//	file at path, for SubwaySystem::apply_delta. Each line of the file is 
+//	either an entrance to add, in the same form as a line of the subway file,
+//	or a minus sign followed by the id of an entrance to remove. Empty lines 
+//	are skipped. Returns false if the file cannot be opened
+bool read_delta_file(const char* path, std::vector<Entrance>& adds,
+										 std::vector<int>& removes);
+
+#endif
+
@@ -13,17 +13,19 @@
 
 #include "subway_line.h"
 
-SubwayLine::SubwayLine() : line_name_(""), identifier_(0UL), stops_() {
+SubwayLine::SubwayLine() : line_name_(""), identifier_(0UL), stops_(), 
+    track_() {
 }
 
 SubwayLine::SubwayLine(std::string line_name, unsigned long identifier) : 
-    line_name_(line_name), identifier_(identifier), stops_() {
+    line_name_(line_name), identifier_(identifier), stops_(), track_() {
 }
 
 SubwayLine::SubwayLine(const SubwayLine& other_subway_line) {
 	line_name_ = other_subway_line.line_name_;
 	identifier_ = other_subway_line.identifier_;
 	stops_ = other_subway_line.stops_;
+	track_ = other_subway_line.track_;
 }
 
 SubwayLine::~SubwayLine()
@@ -34,6 +36,7 @@ SubwayLine& SubwayLine::operator=(const SubwayLine& other_subway_line) {
 	line_name_ = other_subway_line.line_name_;
 	identifier_ = other_subway_line.identifier_;
 	stops_ = other_subway_line.stops_;
+	track_ = other_subway_line.track_;
 	return *this;
 }
 
@@ -45,10 +48,34 @@ void SubwayLine::add_station(const SubwayStation& station) {
 	stops_.push_back(station);
 }
 
+void SubwayLine::remove_station(const std::string& station_name) {
+	for (unsigned int i = 0; i < stops_.size(); ++i) {
+		if (stops_[i].get_station_name() == station_name) {
+			stops_[i] = stops_.back();
+			stops_.pop_back();
+			return;
+		}
+	}
+}
+
+void SubwayLine::move_entrances(const std::vector<unsigned int>& positions) {
+	for (auto& s : stops_) {
+		s.move_entrances(positions);
+	}
+}
+
 std::string SubwayLine::get_line_name() const {
 	return line_name_;
 }
 
-std::vector<SubwayStation> SubwayLine::get_stations() const {
+const std::vector<SubwayStation>& SubwayLine::get_stations() const {
 	return stops_;
 }
+
+void SubwayLine::add_segment(const TrackSegment& segment) {
+	track_.push_back(segment);
+}
+
+const std::vector<TrackSegment>& SubwayLine::get_track() const {
+	return track_;
+}
@@ -36,8 +36,25 @@
 		the bit representing a specific SubwayLine in SubwayStation's identifier_ 
 		member is set to 1. There are 26 train lines in New York City. 
 
+		A SubwayLine object also stores its track, a polyline of TrackSegment
+		objects that each join two of its stations that are next to each other on
+		the line. Where the line branches, more than one segment starts at the 
+		same station.
+
 *******************************************************************************/
 
+//	A straight stretch of track between two stations that a line stops at one
+//	after the other
+struct TrackSegment {
+	//	Coordinates of the station at the start of the segment
+	double latitude1;
+	double longitude1;
+
+	//	Coordinates of the station at the end of the segment
+	double latitude2;
+	double longitude2;
+};
+
 class SubwayLine {
  public:
 	//	Default constructor for SubwayLine object
@@ -62,11 +79,24 @@ class SubwayLine {
 	//	Adds station to SubwayLine's stops_ member
 	void add_station(const SubwayStation& station);
 
+	//	Removes the station named station_name from SubwayLine's stops_ member.
+	//	The last station takes its place
+	void remove_station(const std::string& station_name);
+
+	//	Calls move_entrances(positions) on every station in stops_
+	void move_entrances(const std::vector<unsigned int>& positions);
+
 	//	Returns SubwayLine's line_name_ member
 	std::string get_line_name() const;
 
-	//	Returns SubwayLine's stops_ member
-	std::vector<SubwayStation> get_stations() const;
+	//	Returns an unmodifiable reference to SubwayLine's stops_ member
+	const std::vector<SubwayStation>& get_stations() const;
+
+	//	Adds segment to the end of SubwayLine's track_ member
+	void add_segment(const TrackSegment& segment);
+
+	//	Returns an unmodifiable reference to SubwayLine's track_ member
+	const std::vector<TrackSegment>& get_track() const;
 
  private:
 	//	String representing the name of this subway line
@@ -79,6 +109,10 @@ class SubwayLine {
 	//	stations in the container does not correspond to the real life order that
 	//	the subway line stops at these stations
 	std::vector<SubwayStation> stops_;
+
+	//	The segments of track that join the stations in stops_, starting at one
+	//	end of the line
+	std::vector<TrackSegment> track_;
 };
 
 #endif
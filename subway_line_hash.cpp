@@ -13,16 +13,28 @@
 *******************************************************************************/
 
 #include "subway_line_hash.h"
+#include "string_hash.h"
 #include <iostream>
 
-SubwayLineHash::SubwayLineHash(int size) :
-    table_(size, HashEntry<SubwayLine>(SubwayLine())), current_size_(0)
+std::string LineKey::name(const SubwayLine& line) {
+	return line.get_line_name();
+}
+
+uint64_t LineKey::hash(const std::string& name) {
+	return hash_string(name);
+}
+
+bool LineKey::equal(const std::string& stored, const std::string& name) {
+	return stored == name;
+}
+
+SubwayLineHash::SubwayLineHash(int size) : table_(size)
 {
 }
 
-SubwayLineHash::SubwayLineHash(const SubwayLineHash& other_table) {
-	table_ = other_table.table_;
-	current_size_ = other_table.current_size_;
+SubwayLineHash::SubwayLineHash(const SubwayLineHash& other_table) :
+    table_(other_table.table_)
+{
 }
 
 SubwayLineHash::~SubwayLineHash()
@@ -30,92 +42,50 @@ SubwayLineHash::~SubwayLineHash()
 }
 
 void SubwayLineHash::insert(const SubwayLine& line) {
-	int position = find_pos(line.get_line_name());
-	if (table_[position].active()) {
-		return;
-	}
-
-	HashEntry<SubwayLine> entry(line, ACTIVE);
-	table_[position] = entry;
-	if (((unsigned)++current_size_) > (table_.size() / 2)) {
-		rehash();
-	}
+	table_.insert(line);
 }
 
 void SubwayLineHash::remove(const std::string& line_name) {
-	int position = hash(line_name);
-	if (table_[position].active()) {
-		table_[position].status = DELETED;
-	}
+	table_.remove(line_name);
 }
 
 void SubwayLineHash::clear() {
-	for (auto& entry : table_) {
-		entry.status = DELETED;
-	}
+	table_.clear();
 }
 
 const SubwayLine& SubwayLineHash::find(const std::string& line_name) const {
-	int position = find_pos(line_name);
-	if (table_[position].active()) {
-		return table_[position].data;
-	}
-	return kNonexistent;
+	const SubwayLine* line = table_.find(line_name);
+	return line ? *line : kNonexistent;
 }
 
 int SubwayLineHash::size() const {
-	return current_size_;
+	return table_.size();
 }
 
-/*******************************************************************************
-
-																		PRIVATE
-
-*******************************************************************************/
-
-unsigned int SubwayLineHash::find_pos(const std::string& line_name) const {
-	int offset = 1;
-	unsigned int pos = hash(line_name);
-	SubwayLine line(table_[pos].data);
-
-	while ((table_[pos].status != EMPTY) && (line.get_line_name() != line_name)) {
-		pos += offset;
-		offset += 2;
-		if (pos >= table_.size()) {
-			pos -= table_.size();
+void SubwayLineHash::add_station(const SubwayStation& station) {
+	table_.for_each([&station](SubwayLine& line) {
+		if (station.contains_line(line.get_identifier())) {
+			line.add_station(station);
 		}
-		line = table_[pos].data;
-	}
-	return pos;
+	});
 }
 
-int SubwayLineHash::hash(const std::string line_name) const {
-	long long value = encode(line_name);
-	return (value % table_.size());
+void SubwayLineHash::remove_station(const SubwayStation& station) {
+	const std::string& name = station.get_station_name();
+	table_.for_each([&station, &name](SubwayLine& line) {
+		if (station.contains_line(line.get_identifier())) {
+			line.remove_station(name);
+		}
+	});
 }
 
-long long SubwayLineHash::encode(const std::string line_name) const {
-	long long value = 0;
-	for (unsigned int i = 0; i < line_name.length(); ++i) {
-		value = line_name[i] + (25 * value);	//	25 symbols are used to name lines
-	}
-	return value;
+void SubwayLineHash::move_entrances(
+    const std::vector<unsigned int>& positions) {
+	table_.for_each([&positions](SubwayLine& line) {
+		line.move_entrances(positions);
+	});
 }
 
-void SubwayLineHash::rehash() {
-	std::vector< HashEntry<SubwayLine> > old_table = table_;
-	current_size_ = 0;
-	table_.resize(127);
-
-	for (auto& entry : table_) {
-		entry.status = EMPTY;
-	}
-
-	for (auto& entry : old_table) {
-		if (entry.active()) {
-			insert(entry.data);
-		}
-	}
+HashStats SubwayLineHash::statistics() const {
+	return table_.statistics();
 }
-
-
@@ -17,25 +17,31 @@
 
 #include <vector>
 #include <string>
-#include "hash_entry.cpp"
+#include "hash_table.h"
 #include "subway_line.h"
 
 /*******************************************************************************
 
 		The SubwayLineHash class is a hash table that stores SubwayLine objects. 
-		Its default size is 59 since there are 26 subway lines in New York City. 
-		This table uses a division-based hash function to insert SubwayLine objects. 
-		This table stores the SubwayLine objects using a vector of HashEntry objects 
-		that store SubwayLine objects.
+		Its default size is 59 since there are 26 subway lines in New York City,
+		and it grows as more lines are inserted. It stores the SubwayLine objects
+		in a HashTable, keyed by their names, which are hashed with hash_string.
 
 *******************************************************************************/
 
 const SubwayLine kNonexistent;
 
+//	Names, hashes and compares SubwayLine objects for HashTable
+struct LineKey {
+	static std::string name(const SubwayLine& line);
+	static uint64_t hash(const std::string& name);
+	static bool equal(const std::string& stored, const std::string& name);
+};
+
 class SubwayLineHash {
  public:
-	//	Creates a SubwayLineHash object whose default size is 59 if an integer
-	//	argument is not provided
+	//	Creates a SubwayLineHash object with room for at least size slots, 59 if
+	//	an integer argument is not provided
 	explicit SubwayLineHash(int size = 59);
 
 	//	Creates a SubwayLineHash object that is an exact copy of other_table
@@ -57,31 +63,23 @@ class SubwayLineHash {
 	//	in this SubwayLineHash object. If it does not exist, returns kNonexistent
 	const SubwayLine& find(const std::string& line_name) const;
 
-	//	Returns SubwayLineHash object's current_size_ member
+	//	Returns the number of SubwayLine objects in table_
 	int size() const;
 
+	//	Adds station to, or removes it from, every line in table_ that stops at
+	//	it
+	void add_station(const SubwayStation& station);
+	void remove_station(const SubwayStation& station);
+
+	//	Calls move_entrances(positions) on every line in table_
+	void move_entrances(const std::vector<unsigned int>& positions);
+
+	//	Returns how the lines are spread over table_
+	HashStats statistics() const;
+
  private:
-	//	Vector that stores SubwayLine objects
-	std::vector< HashEntry<SubwayLine> > table_;
-	
-	//	An integer representing how many SubwayLine objects are in table_
-	int current_size_;
-
-	//	Returns an integer that is the index in table_ at which the SubwayLine
-	//	object whose name is line_name will be inserted. Finds a position for
-	//	the SubwayLine object in table_
-	unsigned int find_pos(const std::string& line_name) const;
-
-	//	Returns an integer that is the index in table_ at which the SubwayLine
-	//	object whose name is line_name will be inserted
-	int hash(const std::string line_name) const;
-
-	//	Returns a very large integer value representing line_name
-	long long encode(const std::string line_name) const;
-
-	//	When table_ becomes half full, increases table_'s capacity more than two
-	//	times its current capacity and rehashes all of its entries into table_
-	void rehash();
+	//	Hash table that stores SubwayLine objects
+	HashTable<SubwayLine, LineKey> table_;
 };
 
 #endif
@@ -14,16 +14,16 @@
 #include "subway_station.h"
 
 SubwayStation::SubwayStation() : entrance_indices_(), station_name_(""), 
-    identifier_(0UL), station_latitude_(0), station_longitude_(0) 
+    identifier_(0UL), station_latitude_(0), station_longitude_(0), radius_(0)
 {
 }
 
 SubwayStation::SubwayStation(std::vector<unsigned int> indices_of_entrances, 
 														 std::string name, unsigned long identifier,
-														 double latitude, double longitude) : 
+														 double latitude, double longitude, double radius) : 
     entrance_indices_(indices_of_entrances), station_name_(name), 
     identifier_(identifier), station_latitude_(latitude), 
-    station_longitude_(longitude)
+    station_longitude_(longitude), radius_(radius)
 {
 }
 
@@ -33,6 +33,7 @@ SubwayStation::SubwayStation(const SubwayStation& other_station) {
 	identifier_ = other_station.identifier_;
 	station_latitude_ = other_station.station_latitude_;
 	station_longitude_ = other_station.station_longitude_;
+	radius_ = other_station.radius_;
 }
 
 SubwayStation::~SubwayStation() 
@@ -45,6 +46,7 @@ SubwayStation& SubwayStation::operator=(const SubwayStation& other_station) {
 	identifier_ = other_station.identifier_;
 	station_latitude_ = other_station.station_latitude_;
 	station_longitude_ = other_station.station_longitude_;
+	radius_ = other_station.radius_;
 	return *this;
 }
 
@@ -52,7 +54,7 @@ unsigned long SubwayStation::get_identifier() const {
 	return identifier_;
 }
 
-std::string SubwayStation::get_station_name() const {
+const std::string& SubwayStation::get_station_name() const {
 	return station_name_;
 }
 
@@ -61,10 +63,20 @@ void SubwayStation::get_coordinates(double& lat, double& lon) const {
 	lon = station_longitude_;
 }
 
-std::vector<unsigned int> SubwayStation::get_entrance_positions() const {
+double SubwayStation::get_radius() const {
+	return radius_;
+}
+
+const std::vector<unsigned int>& SubwayStation::get_entrance_positions() const {
 	return entrance_indices_;
 }
 
+void SubwayStation::move_entrances(const std::vector<unsigned int>& positions) {
+	for (auto& i : entrance_indices_) {
+		i = positions[i];
+	}
+}
+
 bool SubwayStation::contains_line(const unsigned long& other_line) const {
 	if ((identifier_ & other_line) == other_line) {
 		return true;
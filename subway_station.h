@@ -29,8 +29,10 @@
 		the station (all Entrance objects that make up a SubwayStation have 
 		identical line_identifier_ members). SubwayStation's station_latitude_ and 
 		station_longitude_ members are the centroid coordinates of each of its 
-		Entrance object locations. There are 451 total subway station in 
-		New York City.
+		Entrance object locations. Its radius_ member is the distance from the 
+		centroid to its farthest Entrance object, so no entrance of the station is
+		closer to a point than the station's distance minus its radius. There are 
+		451 total subway station in New York City.
 
 *******************************************************************************/
 
@@ -42,7 +44,7 @@ class SubwayStation {
 	//	Constructor for SubwayStation object
 	SubwayStation(std::vector<unsigned int> indices_of_entrances, 
 								std::string name, unsigned long identifier, double latitude,
-								double longitude);
+								double longitude, double radius = 0);
 
 	//	Makes this SubwayStation object an exact copy of other_station
 	SubwayStation(const SubwayStation& other_station);
@@ -57,16 +59,25 @@ class SubwayStation {
 	//	Returns SubwayStation object's identifier_ member
 	unsigned long get_identifier() const;
 
-	//	Returns SubwayStation object's station_name_ member
-	std::string get_station_name() const;
+	//	Returns an unmodifiable reference to SubwayStation object's station_name_
+	//	member
+	const std::string& get_station_name() const;
 
 	//	Sets lat equal to SubwayStation object's station_latitude_ member and
 	//	sets lon equal to SubwayStation object's station_longitude_ member
 	void get_coordinates(double& lat, double& lon) const;
 
-	//	Returns a vector containing the indicies of SubwayStation object's 
-	//	entrances in SubwaySystem's vector of entrances
-	std::vector<unsigned int> get_entrance_positions() const;
+	//	Returns SubwayStation object's radius_ member
+	double get_radius() const;
+
+	//	Returns an unmodifiable reference to the vector containing the indicies
+	//	of SubwayStation object's entrances in SubwaySystem's vector of entrances
+	const std::vector<unsigned int>& get_entrance_positions() const;
+
+	//	Replaces the position of each entrance, p, with positions[p], for when 
+	//	SubwaySystem's vector of entrances is put in a different order. The 
+	//	entrances keep their order in this SubwayStation object
+	void move_entrances(const std::vector<unsigned int>& positions);
 
 	//	Returns true if this SubwayStation object serves the subway line(s) 
 	//	represented by other_line
@@ -92,6 +103,10 @@ class SubwayStation {
 	//	The longitude of the centroid of SubwayStation object's entrances and 
 	//	exits
 	double station_longitude_;
+
+	//	The distance in kilometers from the centroid to the farthest entrance or
+	//	exit of this station
+	double radius_;
 };
 
 #endif
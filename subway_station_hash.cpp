@@ -14,18 +14,44 @@
 
 #include "subway_station_hash.h"
 #include "haversine.h"
+#include "string_hash.h"
 #include <ctype.h>
 #include <iostream>
 
+//	Returns true if the lowercase forms of stored_name and name are equal
+static bool same_name(const std::string& stored_name, const std::string& name) {
+	if (stored_name.length() != name.length()) {
+		return false;
+	}
+	for (unsigned int i = 0; i < name.length(); ++i) {
+		char c1 = tolower(stored_name[i]);
+		char c2 = tolower(name[i]);
+		if (c1 != c2) {
+			return false;
+		}
+	}
+	return true;
+}
 
-SubwayStationHash::SubwayStationHash(int size) :
-    table_(size, HashEntry<SubwayStation>(SubwayStation())), current_size_(0)
+const std::string& StationKey::name(const SubwayStation& station) {
+	return station.get_station_name();
+}
+
+uint64_t StationKey::hash(const std::string& name) {
+	return hash_string(name, true);
+}
+
+bool StationKey::equal(const std::string& stored, const std::string& name) {
+	return same_name(stored, name);
+}
+
+SubwayStationHash::SubwayStationHash(int size) : table_(size)
 {
 } 
 
-SubwayStationHash::SubwayStationHash(const SubwayStationHash& other_table) {
-	table_ = other_table.table_;
-	current_size_ = other_table.current_size_;
+SubwayStationHash::SubwayStationHash(const SubwayStationHash& other_table) :
+    table_(other_table.table_)
+{
 }
 
 SubwayStationHash::~SubwayStationHash()
@@ -33,181 +59,108 @@ SubwayStationHash::~SubwayStationHash()
 }
 
 void SubwayStationHash::insert(const SubwayStation& station) {
-	unsigned int position = find_pos(station.get_station_name());
-	if (table_[position].active()) {
-		return;
-	}
-	HashEntry<SubwayStation> entry(station, ACTIVE);
-	table_[position] = entry;
-	if (((unsigned)++current_size_) > (table_.size() / 2)) {
-		rehash();
-	}
+	table_.insert(station);
 }
 
 void SubwayStationHash::remove(const std::string& station_name) {
-	int position = hash(station_name);
-	if (table_[position].active()) {
-		table_[position].status = DELETED;
-	}
+	table_.remove(station_name);
 }
 
 void SubwayStationHash::clear() {
-	for (auto& entry : table_) {
-		entry.status = DELETED;
-	}
+	table_.clear();
+}
+
+void SubwayStationHash::reserve(unsigned int stations) {
+	table_.reserve(stations);
 }
 
 const SubwayStation& SubwayStationHash::find(const std::string& station_name) 
     const {
-	std::string lower_name = station_name;
-	for (char& c : lower_name) {
-		c = tolower(c);
-	}
-	unsigned int position = find_pos(lower_name);
-	if (table_[position].active()) {
-		return table_[position].data;
-	}
-	return kNotFound;
+	const SubwayStation* station = table_.find(station_name);
+	return station ? *station : kNotFound;
 }
 
 int SubwayStationHash::size() const {
-	return current_size_;
+	return table_.size();
+}
+
+unsigned int SubwayStationHash::rehashes() const {
+	return table_.rehashes();
 }
 
 void SubwayStationHash::add_stations_to_line(SubwayLine& a_line) const {
-	for (auto& entry : table_) {
-		if (entry.active()) {
-			SubwayStation s(entry.data);
-			if (s.contains_line(a_line.get_identifier())) {
-				a_line.add_station(entry.data);
-			}
+	table_.for_each([&a_line](const SubwayStation& s) {
+		if (s.contains_line(a_line.get_identifier())) {
+			a_line.add_station(s);
 		}
-	}
+	});
+}
+
+void SubwayStationHash::move_entrances(
+    const std::vector<unsigned int>& positions) {
+	table_.for_each([&positions](SubwayStation& s) {
+		s.move_entrances(positions);
+	});
 }
 
 std::vector<std::string> SubwayStationHash::all_stations() const {
 	std::vector<std::string> stations;
-	for (auto& entry : table_) {
-		if (entry.active()) {
-			SubwayStation s = entry.data;
-			stations.push_back(s.get_station_name());
-		}
-	}
+	table_.for_each([&stations](const SubwayStation& s) {
+		stations.push_back(s.get_station_name());
+	});
 	return stations;
 }
 
-std::vector<std::string> SubwayStationHash::nearest_station(
-    const double& latitude, const double& longitude) const {
-
-	std::vector<std::string> station_names;
-	SubwayStation s = table_[0].data;
-	double lat, lon;
-	s.get_coordinates(lat, lon);
-	double distance;
-	double smallest_distance = haversine(latitude, longitude, lat, lon);
-	station_names.push_back(s.get_station_name());
-
-	for (unsigned int i = 1; i < table_.size(); ++i) {
-		if (table_[i].active()) {
-			s = table_[i].data;
-			s.get_coordinates(lat, lon);
-			distance = haversine(latitude, longitude, lat, lon);
-			if (distance < smallest_distance) {
-				smallest_distance = distance;
-				station_names.clear();
-				station_names.push_back(s.get_station_name());
-			} else if (distance == smallest_distance) {
-				station_names.push_back(s.get_station_name());
-			}
+void SubwayStationHash::all_stations(
+    std::vector<const SubwayStation*>& stations) const {
+	stations.clear();
+	table_.for_each([&stations](const SubwayStation& s) {
+		stations.push_back(&s);
+	});
+}
+
+double SubwayStationHash::nearest_station(const double& latitude,
+		const double& longitude, std::vector<const SubwayStation*>& stations,
+		double& runner_up) const {
+	stations.clear();
+	runner_up = HUGE_VAL;
+	double smallest_distance = HUGE_VAL;
+	table_.for_each([&](const SubwayStation& s) {
+		double lat, lon;
+		s.get_coordinates(lat, lon);
+		double distance = haversine(latitude, longitude, lat, lon);
+		if (distance < smallest_distance) {
+			runner_up = smallest_distance;
+			smallest_distance = distance;
+			stations.clear();
+			stations.push_back(&s);
+		} else if (distance == smallest_distance) {
+			stations.push_back(&s);
+		} else if (distance < runner_up) {
+			runner_up = distance;
 		}
-	}
-	return station_names;
+	});
+	return smallest_distance;
 }
 
 void SubwayStationHash::nearest_line(const double& latitude,
 																		 const double& longitude,
 																		 unsigned long& lv) const {
-	SubwayStation s = table_[0].data;
-	double lat, lon;
-	s.get_coordinates(lat, lon);
-	double distance;
-	double smallest_distance = haversine(latitude, longitude, lat, lon);
-	lv |= s.get_identifier();
-
-	for (unsigned int i = 1; i < table_.size(); ++i) {
-		if (table_[i].active()) {
-			s = table_[i].data;
-			s.get_coordinates(lat, lon);
-			distance = haversine(latitude, longitude, lat, lon);
-			if (distance < smallest_distance) {
-				smallest_distance = distance;
-				lv &= 0UL;
-				lv |= s.get_identifier();
-			} else if (distance == smallest_distance) {
-				lv |= s.get_identifier();
-			}
-		}
-	}
-}
-
-/*******************************************************************************
-
-																		PRIVATE
-
-*******************************************************************************/
-
-unsigned int SubwayStationHash::find_pos(const std::string& station_name) const
-{
-	int offset = 1;
-	unsigned int pos = hash(station_name);
-	SubwayStation s(table_[pos].data);
-	std::string name_of_station = s.get_station_name();
-	for (char& c : name_of_station) {
-		c = tolower(c);
-	}
-	while (table_[pos].status != EMPTY && name_of_station != station_name) {
-		pos += offset;
-		offset += 2;
-		if (pos >= table_.size()) {
-			pos -= table_.size();
-		}
-		s = table_[pos].data;
-		name_of_station = s.get_station_name();
-		for (char& c : name_of_station) {
-			c = tolower(c);
+	double smallest_distance = HUGE_VAL;
+	table_.for_each([&](const SubwayStation& s) {
+		double lat, lon;
+		s.get_coordinates(lat, lon);
+		double distance = haversine(latitude, longitude, lat, lon);
+		if (distance < smallest_distance) {
+			smallest_distance = distance;
+			lv &= 0UL;
+			lv |= s.get_identifier();
+		} else if (distance == smallest_distance) {
+			lv |= s.get_identifier();
 		}
-	}
-	return pos;
+	});
 }
 
-int SubwayStationHash::hash(std::string station_name) const {
-	for (char& c : station_name) {
-		c = tolower(c);
-	}
-	long long value = encode(station_name);
-	return (value % table_.size());
-}
-
-long long SubwayStationHash::encode(const std::string station_name) const {
-	long long value = 0;
-	for (unsigned int i = 0; i < station_name.length(); ++i) {
-		if ((i % 2) == 0) {
-			value = station_name[i] + (38 * value);
-		}
-	}
-	return value;
-}
-
-void SubwayStationHash::rehash() {
-	std::vector< HashEntry<SubwayStation> > old_table = table_;
-	current_size_ = 0;
-	table_.resize(1973);
-	for (auto& entry : table_) {
-		entry.status = EMPTY;
-	}
-	for (auto& entry : old_table) {
-		if (entry.active()) {
-			insert(entry.data);
-		}
-	}
+HashStats SubwayStationHash::statistics() const {
+	return table_.statistics();
 }
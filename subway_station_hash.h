@@ -17,7 +17,7 @@
 
 #include <vector>
 #include <string>
-#include "hash_entry.cpp"
+#include "hash_table.h"
 #include "subway_station.h"
 #include "subway_line.h"
 
@@ -25,9 +25,9 @@
 
 		The SubwayStationHash class is a hash table that stores SubwayStation 
 		objects. Its default size is 977 since there are 451 subway stations in 
-		New York City. This table uses a division-based hash function to insert 
-		SubwayStation objects. This table stores the SubwayStation objects using a 
-		vector of HashEntry objects that store SubwayStation objects. 
+		New York City, and it grows as more stations are inserted. It stores 
+		the SubwayStation objects in a HashTable, keyed by the lowercase form of
+		their names, which is hashed with hash_string. 
 		SubwayStationHash contains a few methods that answer queries about 
 		SubwayStation objects, such as the nearest station or line to given 
 		latitude and longitude coordinates and displaying the names of all stations 
@@ -35,14 +35,28 @@
 		object by adding stations that serve that particular line to SubwayLine's 
 		private vector. 
 
+		None of SubwayStationHash's const methods modify the table or keep any 
+		state between calls, so once every station has been inserted, any number 
+		of threads can call them at the same time. Methods that produce several 
+		stations write them into a vector provided by the caller, which lets each 
+		thread reuse its own vector instead of allocating a new one per call.
+
 *******************************************************************************/
 
 const SubwayStation kNotFound;
 
+//	Names, hashes and compares SubwayStation objects for HashTable. Names are
+//	hashed and compared in lowercase
+struct StationKey {
+	static const std::string& name(const SubwayStation& station);
+	static uint64_t hash(const std::string& name);
+	static bool equal(const std::string& stored, const std::string& name);
+};
+
 class SubwayStationHash {
  public:
-	//	Creates a SubwayStationHash object whose default size is 977 if an integer
-	//	argument is not provided
+	//	Creates a SubwayStationHash object with room for at least size slots,
+	//	977 if an integer argument is not provided
 	explicit SubwayStationHash(int size = 977);
 
 	//	Creates a SubwayStationHash object that is an exact copy of other_table
@@ -60,53 +74,57 @@ class SubwayStationHash {
 	//	Removes all SubwayStation objects from table_
 	void clear();
 
+	//	Grows table_, if needed, so that stations stations fit without 
+	//	rehashing
+	void reserve(unsigned int stations);
+
 	//	Returns an unmodifiable reference to a SubwayStation object if it exists
 	//	in this SubwayStationHash object. If it does not exist, returns kNotFound
 	const SubwayStation& find(const std::string& station_name) const;
 
-	//	Returns SubwayStationHash object's current_size_ member
+	//	Returns the number of SubwayStation objects in table_
 	int size() const;
 
+	//	Returns the number of times table_ has been rehashed. References to 
+	//	the stations it returned before are only valid while this stays the 
+	//	same
+	unsigned int rehashes() const;
+
 	//	Helps build SubwayLine object by adding SubwayStation objects to
 	//	SubwayLine's private vector
 	void add_stations_to_line(SubwayLine& a_line) const;
 
+	//	Calls move_entrances(positions) on every station in this 
+	//	SubwayStationHash object
+	void move_entrances(const std::vector<unsigned int>& positions);
+
 	//	Returns a vector that contains the names of every station in this 
 	//	SubwayStationHash object
 	std::vector<std::string> all_stations() const;
 
-	//	Returns a vector that contains the name(s) of the closest station(s) to
-	//	the given latitude and longitude corrdinates
-	std::vector<std::string> nearest_station(const double& latitude, 
-																					 const double& longitude) const;
+	//	Replaces the contents of stations with every station in this
+	//	SubwayStationHash object
+	void all_stations(std::vector<const SubwayStation*>& stations) const;
+
+	//	Replaces the contents of stations with the closest station(s) to the 
+	//	given latitude and longitude coordinates and returns their distance. 
+	//	runner_up is set to the distance of the closest station that is farther
+	//	away
+	double nearest_station(const double& latitude, const double& longitude,
+												 std::vector<const SubwayStation*>& stations,
+												 double& runner_up) const;
 
 	//	Changes lv to reflect the integer value of the closest subway lines to the
 	//	given latitude and longitude coordinates
 	void nearest_line(const double& latitude, const double& longitude,
 										unsigned long& lv) const;
 
+	//	Returns how the stations are spread over table_
+	HashStats statistics() const;
+
  private:
-	//	Vector that stores SubwayStation objects
-	std::vector< HashEntry<SubwayStation> > table_;
-	
-	//	An integer representing how many SubwayStation objects are in table_
-	int current_size_;
-
-	//	Returns an integer that is the index in table_ at which the SubwayStation
-	//	object whose name is station_name will be inserted. Finds a position for
-	//	the SubwayStation object in table_
-	unsigned int find_pos(const std::string& station_name) const;
-
-	//	Returns an integer that is the index in table_ at which the SubwayStation
-	//	object whose name is station_name will be inserted
-	int hash(std::string station_name) const;
-
-	//	Returns a very large integer value representing station_name
-	long long encode(const std::string station_name) const;
-
-	//	When table_ becomes half full, increases table_'s capacity more than two
-	//	times its current capacity and rehashes all of its entries into table_
-	void rehash();
+	//	Hash table that stores SubwayStation objects
+	HashTable<SubwayStation, StationKey> table_;
 };
 
 #endif
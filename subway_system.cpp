@@ -21,12 +21,33 @@
 #include "subway_station_hash.h"
 #include "subway_line_hash.h"
 #include "haversine.h"
+#include "trace.h"
+#include "alloc_stats.h"
+#include "concurrent_union_find.h"
+#include "task_graph.h"
+#include "work_pool.h"
 #include <stdlib.h>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <sstream>
 
-SubwaySystem::SubwaySystem() : entrances_(), station_table_(), line_table_()
+//	Number of entrances whose links a thread finds at a time when a vector of
+//	entrances is added
+static const unsigned int kLinkGrain = 2048;
+
+//	Number of stations that a thread makes at a time
+static const unsigned int kStationGrain = 512;
+
+SubwaySystem::SubwaySystem() : entrances_(), entrance_order_(), unsorted_(0),
+    first_match_(), entrance_positions_(), entrance_grid_(kStationRadius),
+    entrance_ids_(), build_times_(), station_table_(), line_table_(),
+    station_list_(), cache_(), route_graph_(), entrance_nodes_(), hierarchy_(),
+    transfer_matrix_(), track_index_(), line_station_index_(), 
+    distance_matrix_(), station_tree_(), entrance_tree_(), station_reach_(0),
+    built_()
 {
 }
 
@@ -44,138 +65,1061 @@ void SubwaySystem::add(const Entrance& entrance) {
 		Entrance e(entrances_[i].first);
 		e.get_coordinates(lat2, lon2);
 		if (entrance.same_line(e.get_identifier())) {
-			if (0.28 >= haversine(lat1, lon1, lat2, lon2)) {
+			if (kStationRadius >= haversine(lat1, lon1, lat2, lon2)) {
 				unionize(i, entrances_.size() - 1);
+				first_match_.push_back(i);
 				return;
 			}
 		}
 	}
+	first_match_.push_back(-1);
 }
 
-void SubwaySystem::make_subway_system() {
-	make_stations();
-	make_lines();
+void SubwaySystem::add(const std::vector<Entrance>& entrances, 
+											 unsigned int threads) {
+	TRACE_SPAN("add_all");
+	unsigned int first = entrances_.size();
+	entrances_.reserve(first + entrances.size());
+	for (auto& e : entrances) {
+		entrances_.push_back(std::pair<Entrance, int>(e, -1));
+	}
+	first_match_.resize(entrances_.size(), -1);
+
+	//	until make_subway_system sorts them, the entrances are in the order of 
+	//	the file, so every entrance before one can be found in the grid
+	entrance_positions_.resize(entrances_.size());
+	for (unsigned int i = 0; i < entrances_.size(); ++i) {
+		entrance_positions_[i] = i;
+	}
+	{
+		TRACE_SPAN("index_entrances");
+		index_entrances();
+	}
+
+	//	every link goes to an earlier entrance, and the smaller root always
+	//	wins a union, so each set's root is its first entrance whatever order 
+	//	the threads join them in. The links of entrances added one at a time 
+	//	are already known
+	ConcurrentUnionFind sets(entrances_.size());
+	WorkPool pool(threads);
+	pool.parallel_for(0, entrances_.size(), kLinkGrain, 
+										[&](unsigned int, unsigned int begin, unsigned int end) {
+		TRACE_SPAN("link_entrances");
+		std::vector<unsigned int> candidates;
+		for (unsigned int file = begin; file < end; ++file) {
+			if (file >= first) {
+				first_match_[file] = first_match(entrances_[file].first, file, 
+																				 candidates);
+			}
+			if (first_match_[file] >= 0) {
+				sets.unite(file, first_match_[file]);
+			}
+		}
+	});
+
+	//	a root comes before the rest of its set, so it already holds its size
+	//	when they are counted into it
+	for (unsigned int i = 0; i < entrances_.size(); ++i) {
+		unsigned int root = sets.find(i);
+		if (root == i) {
+			entrances_[i].second = -1;
+		} else {
+			entrances_[i].second = root;
+			--entrances_[root].second;
+		}
+	}
 }
 
-void SubwaySystem::list_line_stations(std::string& line_name) {
-	for (char& c : line_name) {
-		c = toupper(c);
+void SubwaySystem::make_subway_system(unsigned int threads) {
+	TRACE_SPAN("make_subway_system");
+	ALLOC_SCOPE("make_subway_system");
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+	auto since = [](Clock::time_point begin) {
+		return std::chrono::duration<double>(Clock::now() - begin).count();
+	};
+
+	//	the Hilbert order of the entrances only needs their coordinates, so it 
+	//	is found while the stations are made. Moving the entrances into it 
+	//	changes the stations, and the lines copy the stations, so they come 
+	//	last, beside the entrance tree. Each station and each line is made on
+	//	its own and then inserted in a fixed order, so the result is the same
+	//	on any number of threads
+	WorkPool pool(threads);
+	TaskGraph graph;
+	double tree = 0;
+	unsigned int stations = graph.add("make_stations", [&](unsigned int) {
+		Clock::time_point begin = Clock::now();
+		make_stations(pool);
+		build_times_.stations = since(begin);
+	});
+	unsigned int order = graph.add("order_entrances", [&](unsigned int) {
+		Clock::time_point begin = Clock::now();
+		order_entrances();
+		build_times_.entrances = since(begin);
+	});
+	unsigned int sorted = graph.add("sort_entrances", [&](unsigned int) {
+		Clock::time_point begin = Clock::now();
+		sort_entrances();
+		station_table_.all_stations(station_list_);
+		entrance_nodes_.assign(entrances_.size(), -1);
+		for (unsigned int i = 0; i < station_list_.size(); ++i) {
+			for (auto& e : station_list_[i]->get_entrance_positions()) {
+				entrance_nodes_[e] = i;
+			}
+		}
+		build_times_.entrances += since(begin);
+	}, { stations, order });
+	graph.add("make_entrance_tree", [&](unsigned int) {
+		Clock::time_point begin = Clock::now();
+		entrance_tree();
+		tree = since(begin);
+	}, { sorted });
+	graph.add("make_lines", [&](unsigned int) {
+		Clock::time_point begin = Clock::now();
+		make_lines(pool);
+		build_times_.lines = since(begin);
+	}, { sorted });
+	graph.run(pool);
+	build_times_.entrances += tree;
+	build_times_.total = since(start);
+}
+
+unsigned int SubwaySystem::apply_delta(const std::vector<Entrance>& adds,
+																			 const std::vector<int>& removes) {
+	TRACE_SPAN("apply_delta");
+	ALLOC_SCOPE("apply_delta");
+	if (entrance_grid_.size() != entrances_.size()) {
+		index_entrances();
+	}
+	unsigned int first_added = first_match_.size();
+	std::vector<unsigned int> candidates;
+	bool tree = built_.entrance_tree.built;
+	bool repacked = false;
+
+	//	the names of the stations that the delta changes, by the position in 
+	//	the subway file of their root, the root of each of their entrances, and
+	//	the position of each station in station_list_. A station is found 
+	//	through its root's parent while none of its entrances have been moved 
+	//	or removed, which is until it is changed
+	std::map<unsigned int, std::string> changed;
+	std::unordered_map<unsigned int, unsigned int> station_of;
+	std::map<const SubwayStation*, int> listed;
+	auto change = [&](unsigned int file) {
+		if (station_of.count(file)) {
+			return;
+		}
+		int position = entrance_positions_[file];
+		int root = entrances_[position].second < 0 ? position 
+																							 : entrances_[position].second;
+		const std::string& name = entrances_[root].first.get_entrance_name();
+		changed[entrance_order_[root]] = name;
+		station_of[file] = entrance_order_[root];
+		const SubwayStation& station = station_table_.find(name);
+		if (station.get_station_name() != "" && !listed.count(&station)) {
+			listed[&station] = entrance_nodes_[station.get_entrance_positions()[0]];
+		}
+		for (auto& i : station.get_entrance_positions()) {
+			station_of[entrance_order_[i]] = entrance_order_[root];
+		}
+	};
+
+	std::vector<unsigned int> removed;
+	for (auto& id : removes) {
+		auto found = entrance_ids_.find(id);
+		if (found == entrance_ids_.end()) {
+			continue;
+		}
+		unsigned int file = found->second;
+		entrance_ids_.erase(found);
+		change(file);
+		double lat, lon;
+		entrances_[entrance_positions_[file]].first.get_coordinates(lat, lon);
+		entrance_grid_.remove(file, lat, lon);
+		removed.push_back(entrance_positions_[file]);
+	}
+	//	the last entrance takes the place of each removed one, which changes its
+	//	station's positions too
+	std::sort(removed.rbegin(), removed.rend());
+	for (auto& position : removed) {
+		unsigned int last = entrances_.size() - 1;
+		entrance_positions_[entrance_order_[position]] = -1;
+		if (tree) {
+			entrance_tree_.remove(position);
+		}
+		if (position != last) {
+			change(entrance_order_[last]);
+			entrances_[position] = entrances_[last];
+			entrance_order_[position] = entrance_order_[last];
+			entrance_nodes_[position] = entrance_nodes_[last];
+			entrance_positions_[entrance_order_[position]] = position;
+			if (tree) {
+				entrance_tree_.move(last, position);
+			}
+			++unsorted_;
+		}
+		entrances_.pop_back();
+		entrance_order_.pop_back();
+		entrance_nodes_.pop_back();
+	}
+
+	for (auto& entrance : adds) {
+		unsigned int file = first_match_.size();
+		int match = first_match(entrance, file, candidates);
+		if (match >= 0 && (unsigned)match < first_added) {
+			change(match);
+		}
+		first_match_.push_back(match);
+		entrance_positions_.push_back(entrances_.size());
+		entrance_order_.push_back(file);
+		entrance_nodes_.push_back(-1);
+		double lat, lon;
+		entrance.get_coordinates(lat, lon);
+		if (tree && entrance_tree_.insert(entrances_.size(), lat, lon)) {
+			repacked = true;
+		}
+		++unsorted_;
+		entrances_.push_back(std::pair<Entrance, int>(entrance, -1));
+		entrance_grid_.insert(file, lat, lon);
+		entrance_ids_[entrance.get_id()] = file;
+	}
+
+	//	an entrance that was joined to a removed one is joined to the next one 
+	//	it would have been joined to, which can be in another station. Only 
+	//	entrances of the removed ones' stations can have been joined to them
+	std::vector<unsigned int> members;
+	for (auto& s : station_of) {
+		members.push_back(s.first);
+	}
+	for (auto& file : members) {
+		int match = first_match_[file];
+		if (entrance_positions_[file] >= 0 && match >= 0 && 
+				entrance_positions_[match] < 0) {
+			const Entrance& entrance = entrances_[entrance_positions_[file]].first;
+			match = first_match_[file] = first_match(entrance, file, candidates);
+			if (match >= 0) {
+				change(match);
+			}
+		}
+	}
+
+	//	every link of the entrances of the changed stations and of the added 
+	//	ones leads to another of them, and to an earlier one, so going through
+	//	them in the order of the subway file finds the root of each one's set
+	//	after the root of the one it is linked to
+	members.clear();
+	for (auto& s : station_of) {
+		if (entrance_positions_[s.first] >= 0) {
+			members.push_back(s.first);
+		}
+	}
+	for (unsigned int file = first_added; file < first_match_.size(); ++file) {
+		members.push_back(file);
+	}
+	std::sort(members.begin(), members.end());
+	std::vector<unsigned int> roots(members.size());
+	std::vector< std::vector<unsigned int> > sets;
+	std::vector<unsigned int> set_of(members.size());
+	for (unsigned int k = 0; k < members.size(); ++k) {
+		int match = first_match_[members[k]];
+		auto linked = std::lower_bound(members.begin(), members.end(), 
+																	 (unsigned int)match);
+		if (match < 0 || linked == members.end() || *linked != (unsigned)match) {
+			set_of[k] = sets.size();
+			sets.push_back(std::vector<unsigned int>());
+		} else {
+			set_of[k] = set_of[linked - members.begin()];
+		}
+		sets[set_of[k]].push_back(entrance_positions_[members[k]]);
 	}
-	LineValue lv = get_linevalue(line_name);
-	if (lv == DEFAULT) {
-		std::cout << "Line named '" << line_name << "' does not exist" << std::endl;
-	} else {
-		SubwayLine line = line_table_.find(line_name);
-		std::vector<SubwayStation> line_stations = line.get_stations();
 
-		std::cout << "Stations serving Line " << line_name << ":" << std::endl;
-		for (auto& i : line_stations) {
-			SubwayStation s(i);
-			std::cout << s.get_station_name() << std::endl;
+	//	a new station takes the place in station_list_ of a removed one, the 
+	//	first one left, or else goes at the end
+	std::vector<int> freed;
+	for (auto& c : changed) {
+		const SubwayStation& station = station_table_.find(c.second);
+		if (station.get_station_name() != "") {
+			freed.push_back(listed[&station]);
+			line_table_.remove_station(station);
+			station_table_.remove(c.second);
+		}
+	}
+	std::sort(freed.rbegin(), freed.rend());
+	unsigned int listed_stations = station_list_.size();
+	unsigned int rehashes = station_table_.rehashes();
+	std::vector< std::pair<unsigned int, std::string> > placed;
+	for (auto& indices : sets) {
+		entrances_[indices[0]].second = -(int)indices.size();
+		for (unsigned int k = 1; k < indices.size(); ++k) {
+			entrances_[indices[k]].second = indices[0];
+		}
+		SubwayStation station = make_station(indices);
+		int place = -1;
+		if (station_table_.find(station.get_station_name()).get_station_name() 
+				== "") {
+			station_table_.insert(station);
+			line_table_.add_station(station);
+			if (freed.empty()) {
+				place = station_list_.size();
+				station_list_.push_back(NULL);
+			} else {
+				place = freed.back();
+				freed.pop_back();
+			}
+			placed.push_back(std::make_pair(place, station.get_station_name()));
+		}
+		for (auto& i : indices) {
+			entrance_nodes_[i] = place;
 		}
 	}
-	std::cout << std::endl;
+
+	//	rehashing the table moves every station, and each one is found again 
+	//	through the place of its first entrance
+	bool rehashed = station_table_.rehashes() != rehashes;
+	std::vector<unsigned int> replaced;
+	if (rehashed) {
+		std::vector<const SubwayStation*> stations;
+		station_table_.all_stations(stations);
+		for (auto& s : stations) {
+			station_list_[entrance_nodes_[s->get_entrance_positions()[0]]] = s;
+		}
+	}
+	for (auto& p : placed) {
+		station_list_[p.first] = &station_table_.find(p.second);
+		replaced.push_back(p.first);
+	}
+
+	//	the last stations move into the places that are left, the last of 
+	//	those first
+	for (auto& place : freed) {
+		unsigned int last = station_list_.size() - 1;
+		if ((unsigned)place != last) {
+			station_list_[place] = station_list_[last];
+			for (auto& i : station_list_[place]->get_entrance_positions()) {
+				entrance_nodes_[i] = place;
+			}
+			replaced.push_back(place);
+		}
+		station_list_.pop_back();
+	}
+	for (unsigned int p = station_list_.size(); p < listed_stations; ++p) {
+		replaced.push_back(p);
+	}
+	std::sort(replaced.begin(), replaced.end());
+	replaced.erase(std::unique(replaced.begin(), replaced.end()), 
+								 replaced.end());
+	update_indexes(replaced, rehashed);
+	if (tree && (repacked || 4 * unsorted_ > entrances_.size())) {
+		resort_entrances();
+	}
+
+	if (cache_) {
+		cache_->clear();
+	}
+	distance_matrix_.clear();
+	return removed.size();
+}
+
+void SubwaySystem::update_indexes(const std::vector<unsigned int>& replaced,
+																	bool rehashed) {
+	TRACE_SPAN("update_indexes");
+	if (rehashed) {
+		if (built_.route_graph.built) {
+			route_graph_.relink(station_list_);
+		}
+		if (built_.transfer_matrix.built) {
+			transfer_matrix_.relink(station_list_);
+		}
+		if (built_.line_station_index.built) {
+			line_station_index_.relink(station_list_);
+		}
+	}
+	if (built_.station_tree.built) {
+		double lat, lon;
+		for (auto& p : replaced) {
+			station_tree_.remove(p);
+			if (p < station_list_.size()) {
+				station_list_[p]->get_coordinates(lat, lon);
+				station_tree_.insert(p, lat, lon);
+				station_reach_ = std::max(station_reach_, 
+																	station_list_[p]->get_radius());
+			}
+		}
+	}
+	if (built_.line_station_index.built) {
+		line_station_index_.update(station_list_, replaced);
+	}
+	if (built_.transfer_matrix.built) {
+		transfer_matrix_.update(station_list_, replaced);
+	}
+	if (built_.route_graph.built) {
+		std::vector<unsigned int> touched;
+		unsigned long lines = route_graph_.update(station_list_, replaced, 
+																							touched);
+		if (hierarchy_.built()) {
+			hierarchy_.update(replaced, touched);
+		}
+		std::vector<TrackSegment> track;
+		for (int line = A; line < DEFAULT && built_.track_index.built; ++line) {
+			if (lines & (1UL << line)) {
+				make_track(line, track);
+				track_index_.update(line, track);
+			}
+		}
+	}
+}
+
+void SubwaySystem::warm(unsigned int threads) {
+	TRACE_SPAN("warm");
+	ALLOC_SCOPE("warm");
+	//	the track index is the only one that needs another, so it waits for
+	//	the route graph in the graph instead of inside its call_once
+	WorkPool pool(threads);
+	TaskGraph graph;
+	unsigned int routes = graph.add("warm_route_graph",
+																	[this](unsigned int) { route_graph(); });
+	graph.add("warm_track_index",
+						[this](unsigned int) { track_index(); }, { routes });
+	graph.add("warm_transfer_matrix",
+						[this](unsigned int) { transfer_matrix(); });
+	graph.add("warm_line_station_index",
+						[this](unsigned int) { line_station_index(); });
+	graph.add("warm_station_tree", [this](unsigned int) { station_tree(); });
+	graph.add("warm_entrance_tree", [this](unsigned int) { entrance_tree(); });
+	graph.run(pool);
+}
+
+const SubwaySystem::BuildTimes& SubwaySystem::build_times() const {
+	return build_times_;
+}
+
+void SubwaySystem::list_line_stations(const std::string& line_name) const {
+	QueryScratch scratch;
+	list_line_stations(line_name, std::cout, scratch);
+}
+
+void SubwaySystem::list_line_stations(const std::string& line_name, 
+																			std::ostream& out,
+																			QueryScratch& scratch) const {
+	if (!find_line_stations(line_name, scratch)) {
+		out << "Line named '" << scratch.text << "' does not exist" << std::endl;
+	} else {
+		out << "Stations serving Line " << scratch.text << ":" << std::endl;
+		for (auto& s : scratch.stations) {
+			out << s->get_station_name() << std::endl;
+		}
+	}
+	out << std::endl;
 }
 
 void SubwaySystem::list_all_stations() const {
-	std::vector<std::string> stations = station_table_.all_stations();
-	std::cout << "All stations:" << std::endl;
-	for (auto& name : stations) {
-		std::cout << name << std::endl;
+	QueryScratch scratch;
+	list_all_stations(std::cout, scratch);
+}
+
+void SubwaySystem::list_all_stations(std::ostream& out, 
+																		 QueryScratch& scratch) const {
+	station_table_.all_stations(scratch.stations);
+	out << "All stations:" << std::endl;
+	for (auto& s : scratch.stations) {
+		out << s->get_station_name() << std::endl;
 	}
-	std::cout << std::endl;
+	out << std::endl;
 }
 
 void SubwaySystem::list_entrances(const std::string& name_of_station) const {
-	//	eliminate extra spaces in name_of_station
-	std::string station_name = name_of_station;
-	station_name.erase(std::unique(station_name.begin(), station_name.end(),
-																 are_spaces), station_name.end());
-	
+	QueryScratch scratch;
+	list_entrances(name_of_station, std::cout, scratch);
+}
 
-	SubwayStation s(station_table_.find(station_name));
-	if (s.get_station_name() == "") {
-		std::cout << "Station '" << station_name << "' does not exist" << std::endl;
+void SubwaySystem::list_entrances(const std::string& name_of_station,
+																	std::ostream& out,
+																	QueryScratch& scratch) const {
+	if (!find_entrances(name_of_station, scratch)) {
+		out << "Station '" << scratch.text << "' does not exist" << std::endl;
 	} else {
-		std::vector<unsigned int> entrance_indices = s.get_entrance_positions();
-
-		std::cout << "The entrances for station '" << station_name << "' are:";
-		std::cout << std::endl;
+		out << "The entrances for station '" << scratch.text << "' are:";
+		out << std::endl;
 
-		for (auto& i : entrance_indices) {
-			Entrance e(entrances_[i].first);
-			std::string name = e.get_entrance_name();
+		for (auto& e : scratch.entrances) {
+			const std::string& name = e->get_entrance_name();
 			if (name[name.length() - 1] != ')') {
-				std::cout << name << std::endl;
+				out << name << std::endl;
 			}
 		}
 	}
-	std::cout << std::endl;
+	out << std::endl;
 }
 
 void SubwaySystem::nearest_station(const double& latitude, 
 																	 const double& longitude) const {
+	QueryScratch scratch;
+	nearest_station(latitude, longitude, std::cout, scratch);
+}
 
-	std::vector<std::string> names = station_table_.nearest_station(latitude,
-																																	longitude);
+void SubwaySystem::nearest_station(const double& latitude,
+																	 const double& longitude, std::ostream& out,
+																	 QueryScratch& scratch) const {
+	find_nearest_stations(latitude, longitude, scratch);
+	display_nearest_stations(latitude, longitude, out, scratch);
+}
 
-	std::cout << "Stations nearest to " << std::setprecision(12) << latitude;
-	std::cout << ", " << std::setprecision(12) << longitude << ":";
-	std::cout << std::endl;
+void SubwaySystem::nearest_line(const double& latitude, const double& longitude)
+																const {
+	QueryScratch scratch;
+	nearest_line(latitude, longitude, std::cout, scratch);
+}
+
+void SubwaySystem::nearest_line(const double& latitude, const double& longitude,
+																std::ostream& out, 
+																QueryScratch& scratch) const {
+	find_nearest_lines(latitude, longitude, scratch);
+	display_nearest_lines(latitude, longitude, out, scratch);
+}
+
+void SubwaySystem::closest_line(const double& latitude,
+																const double& longitude) const {
+	QueryScratch scratch;
+	closest_line(latitude, longitude, std::cout, scratch);
+}
 
-	for (auto& i : names) {
-		std::cout << i << std::endl;
+void SubwaySystem::closest_line(const double& latitude, const double& longitude,
+																std::ostream& out, 
+																QueryScratch& scratch) const {
+	out << "Closest lines to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << ":" << std::endl;
+	if (find_closest_lines(latitude, longitude, scratch)) {
+		unsigned int k = 0;
+		for (int i = A; i < DEFAULT; ++i) {
+			if (scratch.lines & (1UL << i)) {
+				out << convert_to_string(i) << " at ";
+				out << std::setprecision(9) << scratch.points[k].first << ", ";
+				out << std::setprecision(9) << scratch.points[k].second << std::endl;
+				++k;
+			}
+		}
+		out << "Distance: " << (long)(scratch.distance * 1000 + 0.5);
+		out << " meters" << std::endl;
 	}
-	std::cout << std::endl;
+	out << std::endl;
 }
 
-void SubwaySystem::nearest_line(const double& latitude, const double& longitude)
-																const {
-	unsigned long line_mask = 0UL;
-	station_table_.nearest_line(latitude, longitude, line_mask);
+void SubwaySystem::nearest_station_on_line(const double& latitude,
+																					 const double& longitude,
+																					 const std::string& line_name) 
+																					 const {
+	QueryScratch scratch;
+	nearest_station_on_line(latitude, longitude, line_name, std::cout, scratch);
+}
 
-	std::cout << "Nearest lines to " << std::setprecision(12) << latitude;
-	std::cout << ", " << std::setprecision(12) << longitude << ":";
-	std::cout << std::endl;
+void SubwaySystem::nearest_station_on_line(const double& latitude,
+																					 const double& longitude,
+																					 const std::string& line_name,
+																					 std::ostream& out,
+																					 QueryScratch& scratch) const {
+	if (!find_nearest_station_on_line(latitude, longitude, line_name, 
+																		scratch)) {
+		out << "Line named '" << scratch.text << "' does not exist" << std::endl;
+		out << std::endl;
+		return;
+	}
+	out << "Station nearest to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << " on line ";
+	out << scratch.text << ":" << std::endl;
+	for (auto& s : scratch.stations) {
+		out << s->get_station_name() << std::endl;
+		out << "Distance: " << (long)(scratch.distance * 1000 + 0.5);
+		out << " meters" << std::endl;
+	}
+	out << std::endl;
+}
+
+void SubwaySystem::nearest_station_by_line(const double& latitude,
+																					 const double& longitude) const {
+	QueryScratch scratch;
+	nearest_station_by_line(latitude, longitude, std::cout, scratch);
+}
+
+void SubwaySystem::nearest_station_by_line(const double& latitude,
+																					 const double& longitude,
+																					 std::ostream& out,
+																					 QueryScratch& scratch) const {
+	find_nearest_station_by_line(latitude, longitude, scratch);
+	out << "Stations nearest to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << " on each line:";
+	out << std::endl;
 	for (int i = A; i < DEFAULT; ++i) {
-		unsigned long mask = 1UL << i;
-		if ((line_mask & mask) == mask) {
-			std::cout << convert_to_string(i) << std::endl;
+		if (scratch.stations[i]) {
+			out << convert_to_string(i) << ": ";
+			out << scratch.stations[i]->get_station_name() << " (";
+			out << (long)(scratch.distances[i] * 1000 + 0.5) << " meters)";
+			out << std::endl;
 		}
 	}
-	std::cout << std::endl;
+	out << std::endl;
+}
+
+void SubwaySystem::in_box(const double& latitude1, const double& longitude1,
+													const double& latitude2, const double& longitude2,
+													bool entrances) const {
+	QueryScratch scratch;
+	in_box(latitude1, longitude1, latitude2, longitude2, entrances, std::cout,
+				 scratch);
+}
+
+void SubwaySystem::in_box(const double& latitude1, const double& longitude1,
+													const double& latitude2, const double& longitude2,
+													bool entrances, std::ostream& out,
+													QueryScratch& scratch) const {
+	find_in_box(latitude1, longitude1, latitude2, longitude2, entrances, 
+							scratch);
+	std::ostringstream heading;
+	heading << std::setprecision(12) << latitude1 << ", " << longitude1;
+	heading << " to " << latitude2 << ", " << longitude2;
+	display_found("box from " + heading.str(), entrances, out, scratch);
+}
+
+void SubwaySystem::in_polygon(const std::vector<HilbertRTree::Vertex>& polygon,
+															bool entrances) const {
+	QueryScratch scratch;
+	in_polygon(polygon, entrances, std::cout, scratch);
+}
+
+void SubwaySystem::in_polygon(const std::vector<HilbertRTree::Vertex>& polygon,
+															bool entrances, std::ostream& out,
+															QueryScratch& scratch) const {
+	find_in_polygon(polygon, entrances, scratch);
+	std::ostringstream heading;
+	heading << "polygon of " << polygon.size() << " vertices";
+	display_found(heading.str(), entrances, out, scratch);
 }
 
 void SubwaySystem::nearest_entrance(const double& latitude,
 																		const double& longitude) const {
-	std::vector<std::string> entrance_names;
-	Entrance e = entrances_[0].first;
-	double lat, lon;
-	e.get_coordinates(lat, lon);
-	double distance;
-	double smallest_distance = haversine(latitude, longitude, lat, lon);
-	entrance_names.push_back(e.get_entrance_name());
-
-	for (unsigned int i = 1; i < entrances_.size(); ++i) {
-		e = entrances_[i].first;
-		e.get_coordinates(lat, lon);
-		distance = haversine(latitude, longitude, lat, lon);
-		if (distance < smallest_distance) {
-			smallest_distance = distance;
-			entrance_names.clear();
-			entrance_names.push_back(e.get_entrance_name());
-		} else if (distance == smallest_distance) {
-			entrance_names.push_back(e.get_entrance_name());
+	QueryScratch scratch;
+	nearest_entrance(latitude, longitude, std::cout, scratch);
+}
+
+void SubwaySystem::nearest_entrance(const double& latitude,
+																		const double& longitude, std::ostream& out,
+																		QueryScratch& scratch) const {
+	find_nearest_entrances(latitude, longitude, scratch);
+	display_nearest_entrances(latitude, longitude, out, scratch);
+}
+
+void SubwaySystem::nearest_all(const double& latitude,
+															 const double& longitude) const {
+	QueryScratch scratch;
+	nearest_all(latitude, longitude, std::cout, scratch);
+}
+
+void SubwaySystem::nearest_all(const double& latitude, const double& longitude,
+															 std::ostream& out, 
+															 QueryScratch& scratch) const {
+	find_nearest_all(latitude, longitude, scratch);
+	display_nearest_entrances(latitude, longitude, out, scratch);
+	display_nearest_stations(latitude, longitude, out, scratch);
+	display_nearest_lines(latitude, longitude, out, scratch);
+}
+
+void SubwaySystem::route(const std::string& from, const std::string& to) 
+		const {
+	QueryScratch scratch;
+	route(from, to, std::cout, scratch);
+}
+
+void SubwaySystem::route(const std::string& from, const std::string& to,
+												 std::ostream& out, QueryScratch& scratch) const {
+	const SubwayStation* start = find_station(from, scratch.text);
+	if (!start) {
+		out << "Station '" << scratch.text << "' does not exist" << std::endl;
+		out << std::endl;
+		return;
+	}
+	const SubwayStation* finish = find_station(to, scratch.text);
+	if (!finish) {
+		out << "Station '" << scratch.text << "' does not exist" << std::endl;
+		out << std::endl;
+		return;
+	}
+
+	out << "Route from '" << start->get_station_name() << "' to '";
+	out << finish->get_station_name() << "':" << std::endl;
+	if (!find_path(start, finish, scratch)) {
+		out << "There is no route" << std::endl << std::endl;
+		return;
+	}
+
+	out << scratch.stations[0]->get_station_name() << std::endl;
+	display_rides(out, scratch);
+	out << "Travel time: about " << (long)(scratch.distance + 0.5);
+	out << " minutes" << std::endl << std::endl;
+}
+
+void SubwaySystem::walk_route(const double& latitude, const double& longitude,
+															const double& to_latitude,
+															const double& to_longitude) const {
+	QueryScratch scratch;
+	walk_route(latitude, longitude, to_latitude, to_longitude, std::cout, 
+						 scratch);
+}
+
+void SubwaySystem::walk_route(const double& latitude, const double& longitude,
+															const double& to_latitude,
+															const double& to_longitude, std::ostream& out,
+															QueryScratch& scratch) const {
+	out << "Route from " << std::setprecision(12) << latitude << ", ";
+	out << std::setprecision(12) << longitude << " to ";
+	out << std::setprecision(12) << to_latitude << ", ";
+	out << std::setprecision(12) << to_longitude << ":" << std::endl;
+	if (!find_walk_route(latitude, longitude, to_latitude, to_longitude, 
+											 scratch)) {
+		out << "There is no route" << std::endl << std::endl;
+		return;
+	}
+	if (!scratch.stations.empty()) {
+		out << "  Walk to " << scratch.stations[0]->get_station_name();
+		out << std::endl;
+		display_rides(out, scratch);
+	}
+	out << "  Walk to " << std::setprecision(12) << to_latitude << ", ";
+	out << std::setprecision(12) << to_longitude << std::endl;
+	out << "Travel time: about " << (long)(scratch.distance + 0.5);
+	out << " minutes" << std::endl << std::endl;
+}
+
+void SubwaySystem::transfers(const std::string& from_line,
+														const std::string& to_line) const {
+	QueryScratch scratch;
+	transfers(from_line, to_line, std::cout, scratch);
+}
+
+void SubwaySystem::transfers(const std::string& from_line,
+														const std::string& to_line, std::ostream& out,
+														QueryScratch& scratch) const {
+	int lines[2];
+	const std::string* names[2] = { &from_line, &to_line };
+	for (int i = 0; i < 2; ++i) {
+		scratch.text = *names[i];
+		for (char& c : scratch.text) {
+			c = toupper(c);
+		}
+		lines[i] = get_linevalue(scratch.text);
+		if (lines[i] == DEFAULT) {
+			out << "Line named '" << scratch.text << "' does not exist" << std::endl;
+			out << std::endl;
+			return;
 		}
 	}
 
-	std::cout << "Nearest entrances to " << std::setprecision(12) << latitude;
-	std::cout << ", " << std::setprecision(12) << longitude << ":";
-	std::cout << std::endl;
-	for (auto& i : entrance_names) {
-		std::cout << i << std::endl;
+	int count = transfer_matrix().transfers(lines[0], lines[1]);
+	if (count < 0) {
+		out << "Line " << convert_to_string(lines[1]) << " cannot be reached ";
+		out << "from line " << convert_to_string(lines[0]) << std::endl;
+		out << std::endl;
+		return;
+	}
+	out << "Transfers from line " << convert_to_string(lines[0]) << " to line ";
+	out << convert_to_string(lines[1]) << ": " << count << std::endl;
+	for (int line = lines[0]; line != lines[1]; ) {
+		int next = transfer_matrix().next_line(line, lines[1]);
+		out << convert_to_string(line) << " to " << convert_to_string(next);
+		out << " at:" << std::endl;
+		for (auto& s : transfer_matrix().stations(line, next)) {
+			out << s->get_station_name() << std::endl;
+		}
+		line = next;
+	}
+	out << std::endl;
+}
+
+bool SubwaySystem::find_line_stations(const std::string& line_name,
+																			QueryScratch& scratch) const {
+	scratch.text = line_name;
+	for (char& c : scratch.text) {
+		c = toupper(c);
+	}
+	scratch.stations.clear();
+	if (get_linevalue(scratch.text) == DEFAULT) {
+		return false;
+	}
+	const SubwayLine& line = line_table_.find(scratch.text);
+	for (auto& s : line.get_stations()) {
+		scratch.stations.push_back(&s);
+	}
+	return true;
+}
+
+bool SubwaySystem::find_entrances(const std::string& name_of_station,
+																	QueryScratch& scratch) const {
+	//	eliminate extra spaces in name_of_station
+	scratch.text = name_of_station;
+	scratch.text.erase(std::unique(scratch.text.begin(), scratch.text.end(),
+																 are_spaces), scratch.text.end());
+	scratch.entrances.clear();
+
+	const SubwayStation& s = station_table_.find(scratch.text);
+	if (s.get_station_name() == "") {
+		return false;
+	}
+	for (auto& i : s.get_entrance_positions()) {
+		scratch.entrances.push_back(&entrances_[i].first);
+	}
+	return true;
+}
+
+void SubwaySystem::find_nearest_stations(const double& latitude,
+																				 const double& longitude,
+																				 QueryScratch& scratch) const {
+	if (cache_ && cache_->lookup(NEAREST_STATION, latitude, longitude, scratch)) {
+		return;
+	}
+	scratch.distance = station_table_.nearest_station(latitude, longitude, 
+																										scratch.stations, 
+																										scratch.runner_up);
+	scratch.probes += station_list_.size();
+	if (cache_) {
+		cache_->store(NEAREST_STATION, latitude, longitude, scratch);
+	}
+}
+
+void SubwaySystem::find_nearest_lines(const double& latitude,
+																			const double& longitude,
+																			QueryScratch& scratch) const {
+	if (cache_ && cache_->lookup(NEAREST_LINE, latitude, longitude, scratch)) {
+		return;
+	}
+	//	the nearest lines are the lines served by the nearest station(s)
+	scratch.distance = station_table_.nearest_station(latitude, longitude, 
+																										scratch.stations, 
+																										scratch.runner_up);
+	scratch.probes += station_list_.size();
+	scratch.lines = 0UL;
+	for (auto& s : scratch.stations) {
+		scratch.lines |= s->get_identifier();
+	}
+	if (cache_) {
+		cache_->store(NEAREST_LINE, latitude, longitude, scratch);
+	}
+}
+
+bool SubwaySystem::find_closest_lines(const double& latitude,
+																			const double& longitude,
+																			QueryScratch& scratch) const {
+	return track_index().closest_lines(latitude, longitude, scratch);
+}
+
+bool SubwaySystem::find_nearest_station_on_line(const double& latitude,
+																								const double& longitude,
+																								const std::string& line_name,
+																								QueryScratch& scratch) const {
+	scratch.text = line_name;
+	for (char& c : scratch.text) {
+		c = toupper(c);
+	}
+	scratch.stations.clear();
+	int line = get_linevalue(scratch.text);
+	if (line == DEFAULT) {
+		return false;
+	}
+	line_station_index().nearest(latitude, longitude, 1UL << line, 
+															 scratch.stations, scratch.distances);
+	const SubwayStation* station = scratch.stations[line];
+	scratch.distance = scratch.distances[line];
+	scratch.stations.clear();
+	if (station) {
+		scratch.stations.push_back(station);
+	}
+	return true;
+}
+
+void SubwaySystem::find_nearest_station_by_line(const double& latitude,
+																								const double& longitude,
+																								QueryScratch& scratch) const {
+	line_station_index().nearest(latitude, longitude, (1UL << DEFAULT) - 1,
+															 scratch.stations, scratch.distances);
+}
+
+void SubwaySystem::find_in_box(const double& latitude1, 
+															 const double& longitude1,
+															 const double& latitude2, 
+															 const double& longitude2, bool entrances,
+															 QueryScratch& scratch) const {
+	const HilbertRTree& tree = entrances ? entrance_tree() : station_tree();
+	tree.search(std::min(latitude1, latitude2), std::min(longitude1, longitude2),
+							std::max(latitude1, latitude2), std::max(longitude1, longitude2),
+							scratch.indices);
+	collect_found(entrances, scratch);
+}
+
+void SubwaySystem::find_in_polygon(
+    const std::vector<HilbertRTree::Vertex>& polygon, bool entrances,
+    QueryScratch& scratch) const {
+	const HilbertRTree& tree = entrances ? entrance_tree() : station_tree();
+	tree.search(polygon, scratch.indices);
+	collect_found(entrances, scratch);
+}
+
+void SubwaySystem::find_nearest_entrances(const double& latitude,
+																					const double& longitude,
+																					QueryScratch& scratch) const {
+	if (cache_ && cache_->lookup(NEAREST_ENTRANCE, latitude, longitude, 
+															 scratch)) {
+		return;
+	}
+	scratch.entrances.clear();
+	scratch.runner_up = HUGE_VAL;
+	if (entrances_.empty()) {
+		return;
+	}
+	entrance_tree().nearest(latitude, longitude, scratch);
+	collect_entrances(scratch);
+	if (cache_) {
+		cache_->store(NEAREST_ENTRANCE, latitude, longitude, scratch);
+	}
+}
+
+void SubwaySystem::find_nearest_all(const double& latitude,
+																		const double& longitude,
+																		QueryScratch& scratch) const {
+	scratch.stations.clear();
+	scratch.other_indices.clear();
+	scratch.lines = 0UL;
+	const HilbertRTree& tree = station_tree();
+
+	//	the search visits each station it reaches once, and looks at its
+	//	entrances unless none of them can be closer than its distance minus its
+	//	radius; the small margin keeps rounding from skipping a tie. The lambda
+	//	only holds two pointers, so std::function does not allocate for it
+	struct Search {
+		double latitude;
+		double longitude;
+		double entrance_distance;
+		QueryScratch* scratch;
+	} search = { latitude, longitude, HUGE_VAL, &scratch };
+	tree.nearest(latitude, longitude, station_reach_,
+		[this, &search](unsigned int position, double distance) {
+			const SubwayStation* s = station_list_[position];
+			QueryScratch& scratch = *search.scratch;
+			++scratch.probes;
+			if (distance - s->get_radius() <= search.entrance_distance + 1e-9) {
+				double lat, lon;
+				scratch.probes += s->get_entrance_positions().size();
+				for (auto& i : s->get_entrance_positions()) {
+					entrances_[i].first.get_coordinates(lat, lon);
+					distance = haversine(search.latitude, search.longitude, lat, lon);
+					if (distance < search.entrance_distance) {
+						search.entrance_distance = distance;
+						scratch.other_indices.clear();
+						scratch.other_indices.push_back(i);
+					} else if (distance == search.entrance_distance) {
+						scratch.other_indices.push_back(i);
+					}
+				}
+			}
+			return search.entrance_distance + 1e-9;
+		}, scratch);
+
+	for (auto& i : scratch.indices) {
+		scratch.stations.push_back(station_list_[i]);
+		scratch.lines |= station_list_[i]->get_identifier();
+	}
+	//	list tied entrances in the same order as find_nearest_entrances does
+	scratch.indices.swap(scratch.other_indices);
+	collect_entrances(scratch);
+}
+
+bool SubwaySystem::find_route(const std::string& from, const std::string& to,
+															QueryScratch& scratch) const {
+	const SubwayStation* start = find_station(from, scratch.text);
+	const SubwayStation* finish = find_station(to, scratch.text);
+	if (!start || !finish) {
+		scratch.stations.clear();
+		scratch.route_lines.clear();
+		return false;
+	}
+	return find_path(start, finish, scratch);
+}
+
+bool SubwaySystem::find_walk_route(const double& latitude, 
+																	 const double& longitude,
+																	 const double& to_latitude,
+																	 const double& to_longitude,
+																	 QueryScratch& scratch) const {
+	{
+		TRACE_SPAN("walking_stations");
+		find_walking_stations(latitude, longitude, scratch.origins, 
+													scratch.indices);
+		find_walking_stations(to_latitude, to_longitude, scratch.destinations,
+													scratch.indices);
 	}
-	std::cout << std::endl;
+	TRACE_SPAN("shortest_path");
+	bool found = route_graph().shortest_path(scratch.origins, 
+																					 scratch.destinations, scratch);
+	double walk = haversine(latitude, longitude, to_latitude, to_longitude);
+	if (walk <= kWalkingRadius && walk / kWalkSpeed <= scratch.distance) {
+		scratch.stations.clear();
+		scratch.route_lines.clear();
+		scratch.distance = walk / kWalkSpeed;
+		return true;
+	}
+	return found;
+}
+
+const RouteGraph& SubwaySystem::route_graph() const {
+	std::call_once(built_.route_graph.once, [this]() {
+		TRACE_SPAN("build_route_graph");
+		ALLOC_SCOPE("build_route_graph");
+		route_graph_.build(station_list_);
+		built_.route_graph.built = true;
+	});
+	return route_graph_;
+}
+
+void SubwaySystem::enable_hierarchy() {
+	TRACE_SPAN("enable_hierarchy");
+	ALLOC_SCOPE("enable_hierarchy");
+	hierarchy_.build(route_graph());
+}
+
+const ContractionHierarchy& SubwaySystem::hierarchy() const {
+	return hierarchy_;
+}
+
+const TransferMatrix& SubwaySystem::transfer_matrix() const {
+	std::call_once(built_.transfer_matrix.once, [this]() {
+		TRACE_SPAN("build_transfer_matrix");
+		ALLOC_SCOPE("build_transfer_matrix");
+		transfer_matrix_.build(station_list_);
+		built_.transfer_matrix.built = true;
+	});
+	return transfer_matrix_;
+}
+
+bool SubwaySystem::enable_distances(const std::string& path, 
+																		unsigned int threads) {
+	TRACE_SPAN("enable_distances");
+	ALLOC_SCOPE("enable_distances");
+	if (distance_matrix_.load(path, station_list_)) {
+		return true;
+	}
+	WorkPool pool(threads);
+	distance_matrix_.build(station_list_, pool);
+	distance_matrix_.save(path);
+	return false;
+}
+
+const DistanceMatrix& SubwaySystem::distance_matrix() const {
+	return distance_matrix_;
+}
+
+void SubwaySystem::enable_cache(unsigned int capacity, double precision,
+																bool verify_cells) {
+	cache_.reset(new QueryCache(capacity, precision, verify_cells));
+}
+
+const QueryCache* SubwaySystem::cache() const {
+	return cache_.get();
 }
 
 int SubwaySystem::entrances() const {
@@ -186,6 +1130,11 @@ int SubwaySystem::stations() const {
 	return station_table_.size();
 }
 
+void SubwaySystem::hash_statistics(std::ostream& out) const {
+	station_table_.statistics().display(out, "Station table");
+	line_table_.statistics().display(out, "Line table");
+}
+
 /*******************************************************************************
 
 																		PRIVATE
@@ -200,7 +1149,7 @@ void SubwaySystem::unionize(int root1, int root2) {
 	if (root1 != root2) {
 		if(entrances_[root2].second < entrances_[root1].second) {
 			// root2 is deeper
-			if (entrances_[root1].second > 0) {
+			if (entrances_[root1].second >= 0) {
 				entrances_[root2].second = root1;
 			} else {
 				entrances_[root2].second += entrances_[root1].second;
@@ -209,7 +1158,7 @@ void SubwaySystem::unionize(int root1, int root2) {
 		}
 		else {
 			// root1 is deeper
-			if (entrances_[root2].second > 0) {
+			if (entrances_[root2].second >= 0) {
 				entrances_[root1].second = root2;
 			} else {
 				entrances_[root1].second += entrances_[root2].second;
@@ -251,55 +1200,447 @@ int SubwaySystem::find(int x, int& count) {
 	}
 }
 
-void SubwaySystem::make_stations() {
-	//	make all children point directly to their parent
-	for (unsigned int i = 0; i < entrances_.size(); ++i) {
-		find(i);
+void SubwaySystem::make_stations(WorkPool& pool) {
+	TRACE_SPAN("make_stations");
+	{
+		//	make all children point directly to their parent
+		TRACE_SPAN("compress_paths");
+		for (unsigned int i = 0; i < entrances_.size(); ++i) {
+			find(i);
+		}
 	}
 
+	//	every root becomes a station, with its children after it in the order
+	//	of the subway file
+	std::vector< std::vector<unsigned int> > sets;
+	std::vector<unsigned int> set_of(entrances_.size());
 	for (unsigned int i = 0; i < entrances_.size(); ++i) {
 		if (entrances_[i].second < 0) {	//	entrances_[i] is a root
-			std::vector<unsigned int> indices;
-			indices.push_back(i);
-			Entrance e1(entrances_[i].first);
-			std::string station_name = e1.get_entrance_name();
-			unsigned long line_value = e1.get_identifier();
-			double lat, lon;
-			e1.get_coordinates(lat, lon);
-
-			if (entrances_[i].second < -1) {
-				int children = entrances_[i].second + 1;
-				for (unsigned int j = i + 1; j < entrances_.size(); ++j) {
-					if (entrances_[j].second == (signed)i) {
-						indices.push_back(j);	//	add index of child
-						double latitude, longitude;
-						Entrance e2(entrances_[j].first);
-						e2.get_coordinates(latitude, longitude);
-						lat += latitude;	//	do this to calculate centroid
-						lon += longitude;
-						++children;
-					}
-					if (children == 0) {	//	stop when all children found
-						break;
-					}
+			set_of[i] = sets.size();
+			sets.push_back(std::vector<unsigned int>());
+			sets.back().reserve(-entrances_[i].second);
+			sets.back().push_back(i);
+		}
+	}
+	for (unsigned int i = 0; i < entrances_.size(); ++i) {
+		if (entrances_[i].second >= 0) {
+			sets[set_of[entrances_[i].second]].push_back(i);	//	add index of child
+		}
+	}
+
+	std::vector<SubwayStation> stations(sets.size());
+	pool.parallel_for(0, sets.size(), kStationGrain, 
+										[&](unsigned int, unsigned int first, unsigned int last) {
+		for (unsigned int k = first; k < last; ++k) {
+			stations[k] = make_station(sets[k]);
+		}
+	});
+
+	//	the table is only sized once, and filled in the order of the roots
+	station_table_.reserve(stations.size());
+	for (auto& station : stations) {
+		station_table_.insert(station);
+	}
+}
+
+SubwayStation SubwaySystem::make_station(
+    const std::vector<unsigned int>& indices) const {
+	const Entrance& e1 = entrances_[indices[0]].first;
+	double lat, lon;
+	e1.get_coordinates(lat, lon);
+	if (indices.size() > 1) {
+		for (unsigned int k = 1; k < indices.size(); ++k) {
+			double latitude, longitude;
+			entrances_[indices[k]].first.get_coordinates(latitude, longitude);
+			lat += latitude;	//	do this to calculate centroid
+			lon += longitude;
+		}
+		//	calculate centroid value of station
+		lat = lat / indices.size();
+		lon = lon / indices.size();
+	}
+	//	distance from the centroid to the farthest entrance
+	double radius = 0;
+	for (auto& j : indices) {
+		double latitude, longitude;
+		entrances_[j].first.get_coordinates(latitude, longitude);
+		radius = std::max(radius, haversine(lat, lon, latitude, longitude));
+	}
+	return SubwayStation(indices, e1.get_entrance_name(), e1.get_identifier(),
+											 lat, lon, radius);
+}
+
+void SubwaySystem::order_entrances() {
+	TRACE_SPAN("order_entrances");
+	std::vector<double> latitudes, longitudes;
+	double lat, lon;
+	for (auto& e : entrances_) {
+		e.first.get_coordinates(lat, lon);
+		latitudes.push_back(lat);
+		longitudes.push_back(lon);
+	}
+	HilbertRTree tree;
+	tree.build(latitudes, longitudes);
+	entrance_order_ = tree.order();
+}
+
+void SubwaySystem::sort_entrances() {
+	TRACE_SPAN("sort_entrances");
+	//	a parent's position is moved like any other, and a root keeps its 
+	//	negative size
+	std::vector<unsigned int> positions(entrances_.size());
+	for (unsigned int i = 0; i < entrance_order_.size(); ++i) {
+		positions[entrance_order_[i]] = i;
+	}
+	std::vector< std::pair<Entrance, int> > sorted;
+	for (auto& i : entrance_order_) {
+		sorted.push_back(entrances_[i]);
+		if (sorted.back().second >= 0) {
+			sorted.back().second = positions[sorted.back().second];
+		}
+	}
+	entrances_.swap(sorted);
+	station_table_.move_entrances(positions);
+	entrance_positions_.assign(positions.begin(), positions.end());
+}
+
+void SubwaySystem::resort_entrances() {
+	TRACE_SPAN("resort_entrances");
+	std::vector<unsigned int> positions(entrances_.size());
+	std::vector< std::pair<Entrance, int> > sorted;
+	std::vector<unsigned int> files;
+	std::vector<int> nodes;
+	for (auto& i : entrance_tree_.order()) {
+		if (i != HilbertRTree::kNoPoint) {
+			positions[i] = sorted.size();
+			sorted.push_back(entrances_[i]);
+			files.push_back(entrance_order_[i]);
+			nodes.push_back(entrance_nodes_[i]);
+		}
+	}
+	for (auto& e : sorted) {
+		if (e.second >= 0) {
+			e.second = positions[e.second];
+		}
+	}
+	for (auto& p : entrance_positions_) {
+		if (p >= 0) {
+			p = positions[p];
+		}
+	}
+	entrances_.swap(sorted);
+	entrance_order_.swap(files);
+	entrance_nodes_.swap(nodes);
+	station_table_.move_entrances(positions);
+	line_table_.move_entrances(positions);
+	entrance_tree_.renumber();
+	unsorted_ = 0;
+}
+
+void SubwaySystem::make_lines(WorkPool& pool) {
+	TRACE_SPAN("make_lines");
+	std::vector<SubwayLine> lines;
+	for (int i = A; i < DEFAULT; ++i) {
+		lines.push_back(SubwayLine(convert_to_string(i), 1UL << i));
+	}
+	pool.parallel_for(0, lines.size(), 1, 
+										[&](unsigned int, unsigned int first, unsigned int last) {
+		for (unsigned int k = first; k < last; ++k) {
+			TRACE_SPAN("make_line", lines[k].get_line_name());
+			station_table_.add_stations_to_line(lines[k]);
+		}
+	});
+	for (auto& line : lines) {
+		line_table_.insert(line);
+	}
+}
+
+void SubwaySystem::index_entrances() {
+	entrance_grid_.clear();
+	entrance_ids_.clear();
+	double lat, lon;
+	for (unsigned int file = 0; file < entrance_positions_.size(); ++file) {
+		if (entrance_positions_[file] >= 0) {
+			const Entrance& e = entrances_[entrance_positions_[file]].first;
+			e.get_coordinates(lat, lon);
+			entrance_grid_.insert(file, lat, lon);
+			entrance_ids_[e.get_id()] = file;
+		}
+	}
+}
+
+int SubwaySystem::first_match(const Entrance& entrance, unsigned int file,
+															std::vector<unsigned int>& candidates) const {
+	double lat1, lat2, lon1, lon2;
+	entrance.get_coordinates(lat1, lon1);
+	entrance_grid_.candidates(lat1, lon1, candidates);
+	int match = -1;
+	for (auto& i : candidates) {
+		if (i >= file || (match >= 0 && i >= (unsigned)match)) {
+			continue;
+		}
+		const Entrance& e = entrances_[entrance_positions_[i]].first;
+		e.get_coordinates(lat2, lon2);
+		if (entrance.same_line(e.get_identifier()) &&
+				kStationRadius >= haversine(lat1, lon1, lat2, lon2)) {
+			match = i;
+		}
+	}
+	return match;
+}
+
+void SubwaySystem::make_track(int line, 
+															std::vector<TrackSegment>& track) const {
+	const RouteGraph& graph = route_graph();
+	const std::vector<unsigned int>& stops = graph.line_stops(line);
+	const std::vector<unsigned int>& links = graph.line_links(line);
+	track.clear();
+	for (unsigned int k = 1; k < stops.size(); ++k) {
+		TrackSegment segment;
+		graph.station(links[k])->get_coordinates(segment.latitude1,
+																						 segment.longitude1);
+		graph.station(stops[k])->get_coordinates(segment.latitude2,
+																						 segment.longitude2);
+		track.push_back(segment);
+	}
+}
+
+const TrackIndex& SubwaySystem::track_index() const {
+	std::call_once(built_.track_index.once, [this]() {
+		TRACE_SPAN("build_track_index");
+		ALLOC_SCOPE("build_track_index");
+		//	the lines in line_table_ are shared with queries that may be running,
+		//	so the tracks are added to copies of them
+		std::vector<SubwayLine> tracks;
+		std::vector<TrackSegment> track;
+		for (int i = A; i < DEFAULT; ++i) {
+			tracks.push_back(line_table_.find(convert_to_string(i)));
+			make_track(i, track);
+			for (auto& segment : track) {
+				tracks.back().add_segment(segment);
+			}
+		}
+		std::vector<const SubwayLine*> lines;
+		for (auto& line : tracks) {
+			lines.push_back(&line);
+		}
+		track_index_.build(lines);
+		built_.track_index.built = true;
+	});
+	return track_index_;
+}
+
+const LineStationIndex& SubwaySystem::line_station_index() const {
+	std::call_once(built_.line_station_index.once, [this]() {
+		TRACE_SPAN("build_line_station_index");
+		ALLOC_SCOPE("build_line_station_index");
+		line_station_index_.build(station_list_);
+		built_.line_station_index.built = true;
+	});
+	return line_station_index_;
+}
+
+const HilbertRTree& SubwaySystem::station_tree() const {
+	std::call_once(built_.station_tree.once, [this]() {
+		TRACE_SPAN("build_station_tree");
+		ALLOC_SCOPE("build_station_tree");
+		std::vector<double> latitudes, longitudes;
+		double lat, lon;
+		station_reach_ = 0;
+		for (auto& s : station_list_) {
+			s->get_coordinates(lat, lon);
+			latitudes.push_back(lat);
+			longitudes.push_back(lon);
+			station_reach_ = std::max(station_reach_, s->get_radius());
+		}
+		station_tree_.build(latitudes, longitudes);
+		built_.station_tree.built = true;
+	});
+	return station_tree_;
+}
+
+const HilbertRTree& SubwaySystem::entrance_tree() const {
+	std::call_once(built_.entrance_tree.once, [this]() {
+		TRACE_SPAN("build_entrance_tree");
+		ALLOC_SCOPE("build_entrance_tree");
+		std::vector<double> latitudes, longitudes;
+		double lat, lon;
+		for (auto& e : entrances_) {
+			e.first.get_coordinates(lat, lon);
+			latitudes.push_back(lat);
+			longitudes.push_back(lon);
+		}
+		entrance_tree_.build(latitudes, longitudes);
+		built_.entrance_tree.built = true;
+	});
+	return entrance_tree_;
+}
+
+bool SubwaySystem::find_path(const SubwayStation* start, 
+														 const SubwayStation* finish,
+														 QueryScratch& scratch) const {
+	const RouteGraph& graph = route_graph();
+	unsigned int from = graph.node(start);
+	unsigned int to = graph.node(finish);
+	if (hierarchy_.built()) {
+		return hierarchy_.shortest_path(from, to, scratch);
+	}
+	return graph.shortest_path(from, to, scratch);
+}
+
+void SubwaySystem::find_walking_stations(const double& latitude,
+								const double& longitude,
+								std::vector< std::pair<unsigned int, double> >& walks,
+								std::vector<unsigned int>& found) const {
+	walks.clear();
+	route_graph();
+
+	double min_lat, min_lon, max_lat, max_lon;
+	haversine_box(latitude, longitude, kWalkingRadius, min_lat, min_lon, 
+								max_lat, max_lon);
+	entrance_tree().search(min_lat, min_lon, max_lat, max_lon, found);
+
+	//	each station keeps the closest of its entrances within the radius
+	double lat, lon, distance;
+	for (auto& e : found) {
+		if (entrance_nodes_[e] < 0) {
+			continue;
+		}
+		entrances_[e].first.get_coordinates(lat, lon);
+		distance = haversine(latitude, longitude, lat, lon);
+		if (distance <= kWalkingRadius) {
+			walks.push_back(std::make_pair(entrance_nodes_[e], distance));
+		}
+	}
+	std::sort(walks.begin(), walks.end());
+	unsigned int stations = 0;
+	for (unsigned int k = 0; k < walks.size(); ++k) {
+		if (stations == 0 || walks[k].first != walks[stations - 1].first) {
+			walks[stations++] = walks[k];
+		}
+	}
+	walks.resize(stations);
+	for (auto& walk : walks) {
+		walk.second /= kWalkSpeed;
+	}
+}
+
+void SubwaySystem::display_rides(std::ostream& out, 
+																 const QueryScratch& scratch) const {
+	unsigned long riding = 0UL;
+	for (unsigned int i = 1; i < scratch.stations.size(); ++i) {
+		unsigned long lines = scratch.route_lines[i];
+		//	stay on the same train for as long as it goes the right way
+		riding = (riding & lines) ? (riding & lines) : lines;
+		out << "  ";
+		if (riding == 0UL) {
+			out << "Walk";
+		} else {
+			std::string separator = "";
+			for (int j = A; j < DEFAULT; ++j) {
+				if (riding & (1UL << j)) {
+					out << separator << convert_to_string(j);
+					separator = "/";
 				}
-				//	calculate centroid value of station
-				lat = lat / (abs(entrances_[i].second));
-				lon = lon / (abs(entrances_[i].second));
 			}
-			SubwayStation station(indices, station_name, line_value, lat, lon);
-			station_table_.insert(station);
+		}
+		out << " to " << scratch.stations[i]->get_station_name() << std::endl;
+	}
+}
+
+const SubwayStation* SubwaySystem::find_station(const std::string& name,
+																								std::string& text) const {
+	//	eliminate extra spaces in name
+	text = name;
+	text.erase(std::unique(text.begin(), text.end(), are_spaces), text.end());
+	const SubwayStation& s = station_table_.find(text);
+	if (s.get_station_name() == "") {
+		return NULL;
+	}
+	return &s;
+}
+
+void SubwaySystem::collect_found(bool entrances, QueryScratch& scratch) const {
+	scratch.stations.clear();
+	if (entrances) {
+		collect_entrances(scratch);
+		return;
+	}
+	scratch.entrances.clear();
+	for (auto& i : scratch.indices) {
+		scratch.stations.push_back(station_list_[i]);
+	}
+}
+
+void SubwaySystem::collect_entrances(QueryScratch& scratch) const {
+	std::sort(scratch.indices.begin(), scratch.indices.end(),
+						[this](unsigned int a, unsigned int b) {
+							return entrance_order_[a] < entrance_order_[b];
+						});
+	scratch.entrances.clear();
+	for (auto& i : scratch.indices) {
+		scratch.entrances.push_back(&entrances_[i].first);
+	}
+}
+
+void SubwaySystem::display_found(const std::string& heading, bool entrances,
+																 std::ostream& out,
+																 const QueryScratch& scratch) const {
+	out << (entrances ? "Entrances" : "Stations") << " in " << heading << ":";
+	out << std::endl;
+	if (entrances) {
+		for (auto& e : scratch.entrances) {
+			out << e->get_entrance_name() << std::endl;
+		}
+	} else {
+		for (auto& s : scratch.stations) {
+			out << s->get_station_name() << std::endl;
 		}
 	}
+	out << std::endl;
 }
 
-void SubwaySystem::make_lines() {
+void SubwaySystem::display_nearest_stations(const double& latitude,
+																						const double& longitude,
+																						std::ostream& out,
+																						const QueryScratch& scratch) const {
+	out << "Stations nearest to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << ":";
+	out << std::endl;
+
+	for (auto& s : scratch.stations) {
+		out << s->get_station_name() << std::endl;
+	}
+	out << std::endl;
+}
+
+void SubwaySystem::display_nearest_lines(const double& latitude,
+																				 const double& longitude,
+																				 std::ostream& out,
+																				 const QueryScratch& scratch) const {
+	out << "Nearest lines to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << ":";
+	out << std::endl;
 	for (int i = A; i < DEFAULT; ++i) {
 		unsigned long mask = 1UL << i;
-		SubwayLine a_line(convert_to_string(i), mask);
-		station_table_.add_stations_to_line(a_line);
-		line_table_.insert(a_line);
+		if ((scratch.lines & mask) == mask) {
+			out << convert_to_string(i) << std::endl;
+		}
+	}
+	out << std::endl;
+}
+
+void SubwaySystem::display_nearest_entrances(const double& latitude,
+																						 const double& longitude,
+																						 std::ostream& out,
+																						 const QueryScratch& scratch) const {
+	out << "Nearest entrances to " << std::setprecision(12) << latitude;
+	out << ", " << std::setprecision(12) << longitude << ":";
+	out << std::endl;
+	for (auto& e : scratch.entrances) {
+		out << e->get_entrance_name() << std::endl;
 	}
+	out << std::endl;
 }
 
 bool are_spaces(char c1, char c2) {
@@ -22,10 +22,29 @@
 #include "subway_entrance.h"
 #include "subway_station_hash.h"
 #include "subway_line_hash.h"
+#include "query_scratch.h"
+#include "query_cache.h"
+#include "route_graph.h"
+#include "contraction_hierarchy.h"
+#include "transfer_matrix.h"
+#include "track_index.h"
+#include "line_station_index.h"
+#include "distance_matrix.h"
+#include "hilbert_rtree.h"
+#include "entrance_grid.h"
+#include "work_pool.h"
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <string>
 
+//	Distance in kilometers within which an entrance joins the station of an 
+//	earlier entrance that serves every line it serves
+const double kStationRadius = 0.28;
+
 /*******************************************************************************
 
 		The SubwaySystem class acts as database for the New York City subway system. 
@@ -48,10 +67,97 @@
 		LineValue that is defined in the Entrance class's header file. 
 		There are 451 subway stations and 26 train lines in New York City. 
 
+		Once make_subway_system has returned, a SubwaySystem object is only 
+		modified by apply_delta, which must not be called while any query is
+		running. Every query is a const method that writes its results into
+		a QueryScratch object and its output into an ostream, both provided by the 
+		caller, so any number of threads can query the same SubwaySystem object at 
+		the same time as long as each thread uses its own QueryScratch object and 
+		its own ostream. The find_ methods only compute results and the other 
+		query methods also display them. The query methods that take no 
+		QueryScratch or ostream display to std::cout and are meant for 
+		single-threaded use. The nearest station, line and entrance queries can 
+		optionally be answered from a QueryCache, which is safe to share between
+		threads and never changes an answer. Routes between stations are found
+		in a RouteGraph, and transfers between train lines in a TransferMatrix,
+		both of which are built from the stations. The RouteGraph
+		can optionally be preprocessed into a ContractionHierarchy, which then
+		answers route queries faster. Routes between two points start and end 
+		with a walk to a station that has an entrance within kWalkingRadius of 
+		the point, and are found with one search of the RouteGraph that starts 
+		from every such station near the start at once. The tracks of the train
+		lines follow the line stops of the RouteGraph, and a TrackIndex of their
+		segments finds the line whose track passes closest to a point. A 
+		LineStationIndex of the stations finds the closest station on any given
+		train line, or on every line at once. The distances between every pair of
+		stations can optionally be kept in a DistanceMatrix, which is saved to a
+		file so that later runs only need to map it into memory. The stations and
+		the entrances are each indexed by a HilbertRTree, which finds the ones 
+		inside a box or a polygon.
+
+		Apart from the entrance HilbertRTree, which make_subway_system builds 
+		because it decides the order the entrances are stored in, these indexes
+		are built the first time a query needs them, under std::call_once, so a
+		short run only pays for the indexes its queries use. warm builds all of
+		them at once on several threads.
+
+		make_subway_system runs its steps as a TaskGraph on a WorkPool: the 
+		stations are made while the Hilbert order of the entrances is found,
+		the entrances are moved into that order once both are done, and the 
+		lines and the entrance HilbertRTree are then built side by side. The
+		stations and the lines are each made on several threads and inserted
+		into their tables in a fixed order, so the subway system is the same
+		whatever the number of threads. Each step is a task named after it, 
+		whose allocations AllocStats counts in a scope of that name.
+
+		apply_delta adds and removes entrances without making the subway system
+		again. Each entrance remembers the first entrance before it in the 
+		subway file that it was joined to, and the stations are the sets of 
+		entrances that these links connect. A delta only regroups the entrances
+		of the stations whose links it adds, breaks or moves, finding the 
+		entrances near each new one in an EntranceGrid, so its cost grows with 
+		the size of the delta and of the stations it touches rather than with 
+		the number of entrances. Adding a whole vector of entrances at once 
+		finds every entrance's link the same way, on several threads, and joins
+		the linked entrances in a ConcurrentUnionFind, whose root of each set is
+		the entrance that comes first, as it is when they are added one at a 
+		time. The stations, their entrances and the lines are the same sets
+		make_subway_system would make from the subway file with the removed 
+		entrances left out and the added ones at its end, but the stations may
+		be listed, and a line's stops kept, in a different order, since those 
+		follow the order the stations were inserted into their tables.
+
+		A station keeps its position in the list of stations, which the 
+		indexes number the stations by, for as long as it lasts. A new station
+		takes the place of a removed one, or goes at the end, and the last 
+		stations move into the places left over. A delta then updates the 
+		indexes that have been built in place, from the positions whose 
+		stations changed: the HilbertRTrees of the stations and the entrances
+		and the LineStationIndex empty some slots and fill others, setting only
+		the boxes and masks above them again, the RouteGraph and the 
+		TransferMatrix only connect the changed stations and their lines 
+		again, and the TrackIndex only replaces the tracks of those lines. The
+		ContractionHierarchy, if it was enabled, only contracts again the 
+		stations whose shortcuts may have changed. The entrances that deltas
+		add or move are out of the Hilbert order of the entrances until the 
+		entrance HilbertRTree is packed again, or they are a quarter of the 
+		entrances, when the order is restored.
+
 *******************************************************************************/
 
 class SubwaySystem {
  public:
+	//	Seconds that the last call to make_subway_system spent making the 
+	//	stations, putting the entrances in order and making the lines, each 
+	//	counted from the start to the end of its own steps, and in all. Steps
+	//	that run at the same time can add up to more than the total
+	struct BuildTimes {
+		double stations;
+		double entrances;
+		double lines;
+		double total;
+	};
+
 	//	Default constructor for SubwaySystem object
 	SubwaySystem();
 
@@ -61,28 +167,275 @@ class SubwaySystem {
 	//	Adds entrance to SubwaySystem's entrances_ member
 	void add(const Entrance& entrance);
 
-	//	Creates subway system database
-	void make_subway_system();
+	//	Adds every entrance in entrances, in order, grouping them into the same
+	//	sets as adding them one at a time would, on threads threads (one per 
+	//	hardware thread if threads is 0)
+	void add(const std::vector<Entrance>& entrances, unsigned int threads = 1);
+
+	//	Creates subway system database on threads threads (one per hardware 
+	//	thread if threads is 0), with the same result on any number of them. 
+	//	The indexes that only some queries need are built by the first query 
+	//	that needs them
+	void make_subway_system(unsigned int threads = 1);
+
+	//	Adds the entrances in adds to the subway system, after the others, and
+	//	removes the entrances whose ids are in removes, remaking only the 
+	//	stations and lines they change. Ids of entrances that are not in the 
+	//	subway system are ignored. Drops the cached answers and the distance 
+	//	matrix, which enable_cache and enable_distances do not fill again. 
+	//	Returns the number of entrances removed. The indexes that have been 
+	//	built are updated in place. Must be called after make_subway_system and
+	//	never while a query is running
+	unsigned int apply_delta(const std::vector<Entrance>& adds,
+													 const std::vector<int>& removes);
+
+	//	Builds every index that has not been built yet, at the same time on 
+	//	threads threads (one per hardware thread if threads is 0), so that no
+	//	query has to wait for one. Must be called after make_subway_system
+	void warm(unsigned int threads = 0);
+
+	//	Returns how long each step of the last make_subway_system call took
+	const BuildTimes& build_times() const;
 
 	//	Displays all the station names of the stations that the train line whose 
 	//	name is line_name stops at
-	void list_line_stations(std::string& line_name);
+	void list_line_stations(const std::string& line_name) const;
+	void list_line_stations(const std::string& line_name, std::ostream& out,
+													QueryScratch& scratch) const;
 
 	//	Displays all the stations in the subway system
 	void list_all_stations() const;
+	void list_all_stations(std::ostream& out, QueryScratch& scratch) const;
 
 	//	Displays all the entrances that make up the station named name_of_station
 	void list_entrances(const std::string& name_of_station) const;
+	void list_entrances(const std::string& name_of_station, std::ostream& out,
+											QueryScratch& scratch) const;
 
 	//	Displays the closest station(s) to the given latitude and longitude point
 	void nearest_station(const double& latitude, const double& longitude) const;
+	void nearest_station(const double& latitude, const double& longitude,
+											 std::ostream& out, QueryScratch& scratch) const;
 
 	//	Displays the closest train line(s) to the given latitude and longitude 
 	//	point
 	void nearest_line(const double& latitude, const double& longitude) const;
+	void nearest_line(const double& latitude, const double& longitude,
+										std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the train line(s) whose track passes closest to the given 
+	//	latitude and longitude point, the closest point on each of their tracks
+	//	and its distance
+	void closest_line(const double& latitude, const double& longitude) const;
+	void closest_line(const double& latitude, const double& longitude,
+										std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the closest station to the given latitude and longitude point
+	//	at which the train line whose name is line_name stops
+	void nearest_station_on_line(const double& latitude, 
+															 const double& longitude,
+															 const std::string& line_name) const;
+	void nearest_station_on_line(const double& latitude,
+															 const double& longitude,
+															 const std::string& line_name, std::ostream& out,
+															 QueryScratch& scratch) const;
+
+	//	Displays the closest station to the given latitude and longitude point
+	//	on each train line
+	void nearest_station_by_line(const double& latitude,
+															 const double& longitude) const;
+	void nearest_station_by_line(const double& latitude, 
+															 const double& longitude, std::ostream& out,
+															 QueryScratch& scratch) const;
+
+	//	Displays the stations or, if entrances is true, the entrances inside the
+	//	box with the corners at the given latitudes and longitudes, in the same
+	//	order as list_all_stations or the subway file
+	void in_box(const double& latitude1, const double& longitude1,
+							const double& latitude2, const double& longitude2,
+							bool entrances) const;
+	void in_box(const double& latitude1, const double& longitude1,
+							const double& latitude2, const double& longitude2,
+							bool entrances, std::ostream& out, 
+							QueryScratch& scratch) const;
+
+	//	Displays the stations or, if entrances is true, the entrances inside 
+	//	polygon, whose vertices are latitude and longitude pairs in order around
+	//	it, in the same order as list_all_stations or the subway file
+	void in_polygon(const std::vector<HilbertRTree::Vertex>& polygon,
+									bool entrances) const;
+	void in_polygon(const std::vector<HilbertRTree::Vertex>& polygon,
+									bool entrances, std::ostream& out,
+									QueryScratch& scratch) const;
 
 	//	Displays the closest entrance to the given latitude and longitude point
 	void nearest_entrance(const double& latitude, const double& longitude) const;
+	void nearest_entrance(const double& latitude, const double& longitude,
+												std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the closest entrance(s), station(s) and train line(s) to the 
+	//	given latitude and longitude point, in the same form as nearest_entrance,
+	//	nearest_station and nearest_line, respectively
+	void nearest_all(const double& latitude, const double& longitude) const;
+	void nearest_all(const double& latitude, const double& longitude,
+									 std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the fastest route from the station named from to the station 
+	//	named to, with the train line(s) ridden to reach each station on the way
+	void route(const std::string& from, const std::string& to) const;
+	void route(const std::string& from, const std::string& to, 
+						 std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the fastest route from the given latitude and longitude point to
+	//	the point at to_latitude and to_longitude, walking to a station near the
+	//	first point, riding the train line(s) and walking from a station near 
+	//	the second point
+	void walk_route(const double& latitude, const double& longitude,
+									const double& to_latitude, const double& to_longitude) const;
+	void walk_route(const double& latitude, const double& longitude,
+									const double& to_latitude, const double& to_longitude,
+									std::ostream& out, QueryScratch& scratch) const;
+
+	//	Displays the fewest transfers needed to get from the train line named 
+	//	from_line to the train line named to_line, and the stations at which 
+	//	each of those transfers can be made
+	void transfers(const std::string& from_line, 
+								 const std::string& to_line) const;
+	void transfers(const std::string& from_line, const std::string& to_line,
+								 std::ostream& out, QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the stations that the train line whose name is
+	//	line_name stops at. Returns false if there is no such line
+	bool find_line_stations(const std::string& line_name, 
+													QueryScratch& scratch) const;
+
+	//	Sets scratch.entrances to the entrances that make up the station named
+	//	name_of_station. Returns false if there is no such station
+	bool find_entrances(const std::string& name_of_station,
+											QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the closest station(s) to the given latitude and
+	//	longitude point and scratch.distance to their distance
+	void find_nearest_stations(const double& latitude, const double& longitude,
+														 QueryScratch& scratch) const;
+
+	//	Sets scratch.lines to the closest train line(s) to the given latitude and
+	//	longitude point
+	void find_nearest_lines(const double& latitude, const double& longitude,
+													QueryScratch& scratch) const;
+
+	//	Sets scratch.lines to the train line(s) whose track passes closest to the
+	//	given latitude and longitude point, scratch.points to the closest point
+	//	on each of their tracks and scratch.distance to its distance. Unlike
+	//	find_nearest_lines, which only looks at stations, this measures the 
+	//	distance to the track between the stations. Returns false if there are
+	//	no tracks
+	bool find_closest_lines(const double& latitude, const double& longitude,
+													QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the closest station to the given latitude and
+	//	longitude point at which the train line whose name is line_name stops,
+	//	and scratch.distance to its distance. If two stations of the line are
+	//	equally close, the one that comes first in list_all_stations is chosen.
+	//	Returns false if there is no such line
+	bool find_nearest_station_on_line(const double& latitude,
+																		const double& longitude,
+																		const std::string& line_name,
+																		QueryScratch& scratch) const;
+
+	//	Sets scratch.stations and scratch.distances to the closest station to the
+	//	given latitude and longitude point on each train line and its distance,
+	//	indexed by LineValue, in one search. Chooses the same stations as 
+	//	find_nearest_station_on_line
+	void find_nearest_station_by_line(const double& latitude,
+																		const double& longitude,
+																		QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the stations, or if entrances is true, 
+	//	scratch.entrances to the entrances, inside the box with the corners at
+	//	the given latitudes and longitudes, edges included, in the same order as
+	//	list_all_stations or the subway file
+	void find_in_box(const double& latitude1, const double& longitude1,
+									 const double& latitude2, const double& longitude2,
+									 bool entrances, QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the stations, or if entrances is true,
+	//	scratch.entrances to the entrances, inside polygon, in the same order as
+	//	list_all_stations or the subway file
+	void find_in_polygon(const std::vector<HilbertRTree::Vertex>& polygon,
+											 bool entrances, QueryScratch& scratch) const;
+
+	//	Sets scratch.entrances to the closest entrance(s) to the given latitude 
+	//	and longitude point and scratch.distance to their distance
+	void find_nearest_entrances(const double& latitude, const double& longitude,
+															QueryScratch& scratch) const;
+
+	//	Sets scratch.entrances, scratch.stations and scratch.lines to the closest
+	//	entrance(s), station(s) and train line(s) to the given latitude and 
+	//	longitude point, and scratch.distance to the distance of the station(s). 
+	//	Computes the same answers as the three find_nearest_ methods above in
+	//	one search of station_tree_, which looks at the entrances of each 
+	//	station it reaches unless the station is too far away to contain the 
+	//	closest entrance
+	void find_nearest_all(const double& latitude, const double& longitude,
+												QueryScratch& scratch) const;
+
+	//	Sets scratch.stations to the stations along the fastest route from the 
+	//	station named from to the station named to, scratch.route_lines to the 
+	//	train line(s) ridden to reach each of them and scratch.distance to the 
+	//	travel time in minutes. Returns false if either station does not exist 
+	//	or there is no route
+	bool find_route(const std::string& from, const std::string& to,
+									QueryScratch& scratch) const;
+
+	//	Sets scratch.stations, scratch.route_lines and scratch.distance the same
+	//	way as find_route does for the fastest route between the given latitude
+	//	and longitude point and the point at to_latitude and to_longitude. The 
+	//	route starts and ends at stations that have an entrance within 
+	//	kWalkingRadius of the points, and scratch.distance includes the minutes 
+	//	it takes to walk to and from them. If the points are within 
+	//	kWalkingRadius of each other and walking the whole way is faster, 
+	//	scratch.stations is empty. Returns false if there is no route
+	bool find_walk_route(const double& latitude, const double& longitude,
+											 const double& to_latitude, const double& to_longitude,
+											 QueryScratch& scratch) const;
+
+	//	Returns the graph that routes are found in, building it if needed
+	const RouteGraph& route_graph() const;
+
+	//	Preprocesses the graph that routes are found in into a contraction 
+	//	hierarchy, which answers route queries from then on. Must be called 
+	//	after make_subway_system
+	void enable_hierarchy();
+
+	//	Returns the contraction hierarchy, which is empty unless 
+	//	enable_hierarchy has been called
+	const ContractionHierarchy& hierarchy() const;
+
+	//	Returns the matrix of transfers between train lines, building it if 
+	//	needed
+	const TransferMatrix& transfer_matrix() const;
+
+	//	Loads the distances between every pair of stations from the file at 
+	//	path, or computes them on threads threads (one per hardware thread if 
+	//	threads is 0) and saves them to path if the file is missing or was saved
+	//	for other stations. Must be called after make_subway_system. Returns 
+	//	true if the distances were loaded from the file
+	bool enable_distances(const std::string& path, unsigned int threads = 0);
+
+	//	Returns the distances between every pair of stations, which is empty 
+	//	unless enable_distances has been called. Stations are numbered in the 
+	//	same order as the nodes of route_graph
+	const DistanceMatrix& distance_matrix() const;
+
+	//	Answers nearest station, line and entrance queries from a cache of at
+	//	most capacity answers. See QueryCache for the meaning of precision and
+	//	verify_cells
+	void enable_cache(unsigned int capacity, double precision = 1e-4,
+										bool verify_cells = true);
+
+	//	Returns the cache enabled with enable_cache, or NULL if there is none
+	const QueryCache* cache() const;
 
 	//	Returns the number of entrances in SubwaySystem
 	int entrances() const;
@@ -90,6 +443,10 @@ class SubwaySystem {
 	//	Returns the number of stations in SubwaySystem
 	int stations() const;
 
+	//	Displays how the stations and the lines are spread over their hash 
+	//	tables
+	void hash_statistics(std::ostream& out) const;
+
  private:
 	//	Vector that represents disjoint sets of Entrance objects and is used to
 	//	create SubwayStation objects
@@ -97,12 +454,101 @@ class SubwaySystem {
 	//	is the index of the Entrance object's parent
 	std::vector< std::pair<Entrance, int> > entrances_;
 
+	//	The position each entrance in entrances_ had in the subway file. Once
+	//	the system is made, entrances_ is in the order of entrance_tree_'s
+	//	Hilbert curve, and this is used to list entrances in file order. 
+	//	Entrances added by apply_delta are numbered after the file's
+	std::vector<unsigned int> entrance_order_;
+
+	//	The number of entrances that apply_delta has added to entrances_ or 
+	//	moved in it since it was last in the order of entrance_tree_
+	unsigned int unsorted_;
+
+	//	For each entrance, by its position in the subway file, the position in
+	//	the file of the first entrance before it that it was joined to by add, 
+	//	or -1 if there is none
+	std::vector<int> first_match_;
+
+	//	The position in entrances_ of each entrance, by its position in the 
+	//	subway file, or -1 if apply_delta removed it
+	std::vector<int> entrance_positions_;
+
+	//	The positions in the subway file of the entrances, by where they are 
+	//	and by id, which adding a vector of entrances or else the first call to
+	//	apply_delta fills
+	EntranceGrid entrance_grid_;
+	std::unordered_map<int, unsigned int> entrance_ids_;
+
+	//	How long each step of make_subway_system took
+	BuildTimes build_times_;
+
 	//	Hash table that stores SubwayStation objects
 	SubwayStationHash station_table_;
 
 	//	Hash table that stores SubwayLine objects
 	SubwayLineHash line_table_;
 
+	//	Every station in station_table_, so that queries can visit every 
+	//	station without skipping empty table entries. make_subway_system lists
+	//	them in the order of the table, and apply_delta keeps the stations it
+	//	does not change at their positions
+	std::vector<const SubwayStation*> station_list_;
+
+	//	Cache of nearest query answers, if enabled
+	std::unique_ptr<QueryCache> cache_;
+
+	//	Graph of the stations in station_list_, in the same order, used to find 
+	//	routes
+	mutable RouteGraph route_graph_;
+
+	//	The position in station_list_, which is its node in route_graph_, of 
+	//	the station of each entrance in entrances_, or -1 for an entrance whose
+	//	station is not in station_list_
+	std::vector<int> entrance_nodes_;
+
+	//	Preprocessed form of route_graph_, if enabled
+	ContractionHierarchy hierarchy_;
+
+	//	Transfers between the train lines of the stations in station_list_
+	mutable TransferMatrix transfer_matrix_;
+
+	//	Index of the track segments of every line in line_table_
+	mutable TrackIndex track_index_;
+
+	//	Index of the stations in station_list_ by the lines that stop at them
+	mutable LineStationIndex line_station_index_;
+
+	//	Distances between the stations in station_list_, if enabled
+	DistanceMatrix distance_matrix_;
+
+	//	Indexes of the positions of the stations in station_list_ and of the 
+	//	entrances in entrances_. The entrance tree is built by 
+	//	make_subway_system, over the entrances in the order that it decides
+	mutable HilbertRTree station_tree_;
+	mutable HilbertRTree entrance_tree_;
+
+	//	At least the largest radius of the stations in station_tree_, which is
+	//	how much closer an entrance can be than its station. Built with 
+	//	station_tree_, and only raised by apply_delta
+	mutable double station_reach_;
+
+	//	Set once each of the indexes above that are built on first use has been
+	//	built, so that apply_delta only updates the indexes that exist
+	struct IndexFlag {
+		IndexFlag() : once(), built(false) {}
+		std::once_flag once;
+		bool built;
+	};
+	struct IndexFlags {
+		IndexFlag route_graph;
+		IndexFlag transfer_matrix;
+		IndexFlag track_index;
+		IndexFlag line_station_index;
+		IndexFlag station_tree;
+		IndexFlag entrance_tree;
+	};
+	mutable IndexFlags built_;
+
 	//	Performs a union on two disjoint sets in entrances_
 	//	Whichever root has the deeper tree (whichever set is bigger), is the root
 	//	whose tree will be added to
@@ -117,11 +563,110 @@ class SubwaySystem {
 	//	parents point directly to the root of the parent tree that x is a part of
 	int find(int x, int& count);
 
-	//	Creates all SubwayStation objects and hashes them into station_table_
-	void make_stations();
+	//	Creates all SubwayStation objects and hashes them into station_table_,
+	//	making them on the threads of pool
+	void make_stations(WorkPool& pool);
+
+	//	Returns the station of the entrances at the positions in indices, the 
+	//	first of which is the root of their set and the rest in the order of 
+	//	the subway file. The station is named after the root and serves its 
+	//	lines, and its coordinates are the centroid of the entrances
+	SubwayStation make_station(const std::vector<unsigned int>& indices) const;
+
+	//	Sets entrance_order_ to the order of the Hilbert curve of a HilbertRTree
+	//	of the entrances, which is the order entrance_tree_ keeps them in
+	void order_entrances();
+
+	//	Puts entrances_ in the order of entrance_order_, so that the entrances 
+	//	of each leaf of entrance_tree_ are next to each other, and moves the 
+	//	positions stored in the stations and parents to match
+	void sort_entrances();
+
+	//	Puts entrances_ back in the order of entrance_tree_ after apply_delta
+	//	has added or moved some of them, numbers the points of the tree to 
+	//	match, and moves the positions stored in the stations, the lines, the
+	//	parents, entrance_order_, entrance_positions_ and entrance_nodes_
+	void resort_entrances();
+
+	//	Creates all SubwayLine objects and hashes them into line_table_, 
+	//	finding the stations of each line on the threads of pool
+	void make_lines(WorkPool& pool);
+
+	//	Fills entrance_grid_ and entrance_ids_ with every entrance
+	void index_entrances();
+
+	//	Returns the position in the subway file of the first entrance before 
+	//	position file that entrance would be joined to by add, or -1 if there 
+	//	is none. candidates is used for the entrances near it
+	int first_match(const Entrance& entrance, unsigned int file,
+									std::vector<unsigned int>& candidates) const;
+
+	//	Brings the indexes that have been built up to date after apply_delta
+	//	has changed the stations at the positions in replaced, after pointing
+	//	them at the stations again if rehashed is true
+	void update_indexes(const std::vector<unsigned int>& replaced, 
+											bool rehashed);
+
+	//	Sets track to the segments of the track of line, a LineValue, which 
+	//	join its stops in route_graph_
+	void make_track(int line, std::vector<TrackSegment>& track) const;
+
+	//	Return the indexes that are built on first use, building them if 
+	//	needed. Any number of threads can call them at the same time; a thread
+	//	that needs an index while another thread builds it waits for it. The
+	//	tracks of the lines in track_index_ join their stops in route_graph_
+	const TrackIndex& track_index() const;
+	const LineStationIndex& line_station_index() const;
+	const HilbertRTree& station_tree() const;
+	const HilbertRTree& entrance_tree() const;
+
+	//	Finds the fastest route between the stations start and finish in 
+	//	hierarchy_, if it has been built, or in route_graph_ otherwise
+	bool find_path(const SubwayStation* start, const SubwayStation* finish,
+								 QueryScratch& scratch) const;
+
+	//	Sets walks to the nodes of the stations that have an entrance within 
+	//	kWalkingRadius of the given latitude and longitude point, sorted by 
+	//	node, each paired with the minutes it takes to walk from the point to 
+	//	the closest of those entrances. The entrances are found in 
+	//	entrance_tree_, and found is used for them
+	void find_walking_stations(const double& latitude, const double& longitude,
+								std::vector< std::pair<unsigned int, double> >& walks,
+								std::vector<unsigned int>& found) const;
+
+	//	Displays the stations of the route in scratch after the first one, each
+	//	with the train line(s) ridden to reach it, or Walk
+	void display_rides(std::ostream& out, const QueryScratch& scratch) const;
+
+	//	Returns the station named name, or NULL if there is no such station. 
+	//	Sets text to name without its extra spaces
+	const SubwayStation* find_station(const std::string& name, 
+																		std::string& text) const;
+
+	//	Sets scratch.stations or scratch.entrances to the stations or entrances 
+	//	at the positions in scratch.indices
+	void collect_found(bool entrances, QueryScratch& scratch) const;
+
+	//	Sets scratch.entrances to the entrances at the positions in 
+	//	scratch.indices, in the order they are in the subway file
+	void collect_entrances(QueryScratch& scratch) const;
+
+	//	Displays the stations or entrances in scratch after the heading, which
+	//	names the area they were found in
+	void display_found(const std::string& heading, bool entrances, 
+										 std::ostream& out, const QueryScratch& scratch) const;
 
-	//	Creates all SubwayLine objects and hashes them into line_table_
-	void make_lines();
+	//	Display the answers in scratch to nearest queries about the given 
+	//	latitude and longitude point
+	void display_nearest_stations(const double& latitude, 
+																const double& longitude, std::ostream& out,
+																const QueryScratch& scratch) const;
+	void display_nearest_lines(const double& latitude, const double& longitude,
+														 std::ostream& out, 
+														 const QueryScratch& scratch) const;
+	void display_nearest_entrances(const double& latitude, 
+																 const double& longitude, std::ostream& out,
+																 const QueryScratch& scratch) const;
 };
 
 //	Returns true if c1 and c2 are whitespace characters
@@ -0,0 +1,83 @@
+/*******************************************************************************
+  Title          : task_graph.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the TaskGraph class
+  Purpose        : To run pieces of work on a WorkPool as soon as the pieces
+									 they need have finished
+  Usage          : Add tasks to a TaskGraph object, each with the tasks it
+									 must run after, and call run with a WorkPool
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "task_graph.h"
+#include "alloc_stats.h"
+
+TaskGraph::TaskGraph() : nodes_(), unfinished_(0), lock_(), finished_()
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+}
+
+unsigned int TaskGraph::add(const char* name, const WorkPool::Task& task,
+														const std::vector<unsigned int>& after) {
+	unsigned int number = nodes_.size();
+	nodes_.push_back(std::unique_ptr<Node>(new Node()));
+	nodes_.back()->task = task;
+	nodes_.back()->scope = AllocStats::scope(name);
+	nodes_.back()->after = after.size();
+	for (auto& i : after) {
+		nodes_[i]->next.push_back(number);
+	}
+	return number;
+}
+
+void TaskGraph::run(WorkPool& pool) {
+	unfinished_ = nodes_.size();
+	for (auto& node : nodes_) {
+		node->waiting.store(node->after);
+	}
+	//	the other tasks are started by the last of the tasks they run after to
+	//	finish
+	for (unsigned int i = 0; i < nodes_.size(); ++i) {
+		if (nodes_[i]->after == 0) {
+			start(pool, i);
+		}
+	}
+	std::unique_lock<std::mutex> guard(lock_);
+	while (unfinished_ > 0) {
+		finished_.wait(guard);
+	}
+}
+
+unsigned int TaskGraph::size() const {
+	return nodes_.size();
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void TaskGraph::start(WorkPool& pool, unsigned int node) {
+	pool.submit([this, &pool, node](unsigned int worker) {
+		{
+			AllocScope scope(nodes_[node]->scope);
+			nodes_[node]->task(worker);
+		}
+		for (auto& next : nodes_[node]->next) {
+			if (nodes_[next]->waiting.fetch_sub(1) == 1) {
+				start(pool, next);
+			}
+		}
+		std::lock_guard<std::mutex> guard(lock_);
+		if (--unfinished_ == 0) {
+			finished_.notify_all();
+		}
+	});
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+  Title          : task_graph.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the TaskGraph class
+  Purpose        : To run pieces of work on a WorkPool as soon as the pieces
+									 they need have finished
+  Usage          : Add tasks to a TaskGraph object, each with the tasks it
+									 must run after, and call run with a WorkPool
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __TASK_GRAPH_H__
+#define __TASK_GRAPH_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "work_pool.h"
+
+/*******************************************************************************
+
+		The TaskGraph class is a set of tasks and the order they must run in,
+		given as the tasks each one runs after. run submits every task that
+		runs after no other to a WorkPool, and when a task finishes it submits
+		each task that was only waiting for it, from the same worker, so the
+		pool's work stealing spreads the tasks that become ready over the
+		workers. A task can itself split its work with the pool's parallel_for.
+		Each task has a name and runs in the AllocStats scope of that name, so
+		the allocations of every task are counted on their own, while the
+		tasks it starts are submitted in the scope that run was called in.
+
+		Tasks that do not depend on each other may run in any order and at the
+		same time, so each must only write what no task that can run beside it
+		reads or writes. SubwaySystem uses a TaskGraph to make the stations,
+		put the entrances in order, make the lines and build its indexes.
+
+*******************************************************************************/
+
+class TaskGraph {
+ public:
+	//	Creates an empty TaskGraph object
+	TaskGraph();
+
+	//	Destroys TaskGraph object
+	~TaskGraph();
+
+	//	Adds task, which runs in the AllocStats scope named name after every 
+	//	task whose number is in after has finished, and returns its number. 
+	//	name must be a string that is never freed, such as a literal. The tasks
+	//	in after must already have been added
+	unsigned int add(const char* name, const WorkPool::Task& task,
+									 const std::vector<unsigned int>& after =
+									 std::vector<unsigned int>());
+
+	//	Runs every task on pool and blocks until all of them have finished.
+	//	Must not be called from inside a task of pool, nor again before it
+	//	returns
+	void run(WorkPool& pool);
+
+	//	Returns the number of tasks
+	unsigned int size() const;
+
+ private:
+	//	A task, its AllocStats scope, the tasks that run after it, the number
+	//	of tasks it runs after and how many of those have not finished yet 
+	//	during a run
+	struct Node {
+		WorkPool::Task task;
+		unsigned int scope;
+		std::vector<unsigned int> next;
+		unsigned int after;
+		std::atomic<unsigned int> waiting;
+	};
+
+	TaskGraph(const TaskGraph&);
+	TaskGraph& operator=(const TaskGraph&);
+
+	//	The tasks, by number
+	std::vector< std::unique_ptr<Node> > nodes_;
+
+	//	Number of tasks of the current run that have not finished, and the lock
+	//	and condition that run waits on until it is 0
+	unsigned int unfinished_;
+	std::mutex lock_;
+	std::condition_variable finished_;
+
+	//	Submits the task numbered node to pool
+	void start(WorkPool& pool, unsigned int node);
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*******************************************************************************
+  Title          : trace.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the Trace and TraceSpan classes
+  Purpose        : To find out where the time of building the subway system
+									 and answering queries goes, without a profiler
+  Usage          : Build with make OPT=-DSUBWAY_TRACE, put TRACE_SPAN(name) at
+									 the start of each block to time, call Trace::start before
+									 the work and Trace::write after it
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+//	True while spans are recorded
+static std::atomic<bool> recording_spans(false);
+
+//	Time 0 of the trace
+static std::chrono::steady_clock::time_point origin;
+
+//	Writes text to out as a JSON string
+static void write_string(std::ostream& out, const std::string& text) {
+	out << '"';
+	for (auto& c : text) {
+		if (c == '"' || c == '\\') {
+			out << '\\' << c;
+		} else if ((unsigned char)c < 0x20) {
+			out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+					<< (int)c << std::dec << std::setfill(' ');
+		} else {
+			out << c;
+		}
+	}
+	out << '"';
+}
+
+std::mutex Trace::lock_;
+std::vector< std::unique_ptr<Trace::Buffer> > Trace::buffers_;
+
+void Trace::start() {
+	origin = std::chrono::steady_clock::now();
+	recording_spans.store(true);
+}
+
+bool Trace::recording() {
+	return recording_spans.load(std::memory_order_relaxed);
+}
+
+bool Trace::write(const std::string& path) {
+	recording_spans.store(false);
+	std::ofstream out(path.c_str());
+	if (!out) {
+		return false;
+	}
+	//	timestamps and durations are in microseconds
+	out << std::fixed << std::setprecision(3);
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	std::lock_guard<std::mutex> guard(lock_);
+	for (auto& b : buffers_) {
+		out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\","
+				<< "\"pid\":1,\"tid\":" << b->thread << ",\"args\":{\"name\":\""
+				<< (b->thread == 0 ? "main" : "thread ") ;
+		if (b->thread != 0) {
+			out << b->thread;
+		}
+		out << "\"}}";
+		first = false;
+		for (auto& e : b->events) {
+			out << ",\n{\"name\":";
+			write_string(out, e.name);
+			out << ",\"cat\":\"subway\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+					<< b->thread << ",\"ts\":" << e.begin / 1e3 << ",\"dur\":"
+					<< e.duration / 1e3;
+			if (!e.detail.empty()) {
+				out << ",\"args\":{\"detail\":";
+				write_string(out, e.detail);
+				out << "}";
+			}
+			out << "}";
+		}
+	}
+	out << "\n]}\n";
+	return (bool)out;
+}
+
+int64_t Trace::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - origin).count();
+}
+
+void Trace::record(const char* name, const std::string& detail,
+									 int64_t begin, int64_t duration) {
+	Event event = { name, detail, begin, duration };
+	buffer().events.push_back(event);
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+Trace::Buffer& Trace::buffer() {
+	//	the thread that records first is numbered 0 and called main, since
+	//	that is where building starts
+	static thread_local Buffer* mine = NULL;
+	if (!mine) {
+		std::lock_guard<std::mutex> guard(lock_);
+		buffers_.push_back(std::unique_ptr<Buffer>(new Buffer()));
+		mine = buffers_.back().get();
+		mine->thread = buffers_.size() - 1;
+	}
+	return *mine;
+}
+
+TraceSpan::TraceSpan(const char* name, const std::string& detail) :
+    name_(name), detail_(), begin_(-1)
+{
+	if (Trace::recording()) {
+		detail_ = detail;
+		begin_ = Trace::now();
+	}
+}
+
+TraceSpan::~TraceSpan() {
+	if (begin_ >= 0 && Trace::recording()) {
+		Trace::record(name_, detail_, begin_, Trace::now() - begin_);
+	}
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+  Title          : trace.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the Trace and TraceSpan classes
+  Purpose        : To find out where the time of building the subway system
+									 and answering queries goes, without a profiler
+  Usage          : Build with make OPT=-DSUBWAY_TRACE, put TRACE_SPAN(name) at
+									 the start of each block to time, call Trace::start before
+									 the work and Trace::write after it
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+
+		A TraceSpan object times the block it is declared in, from its creation
+		to the end of the block, and the spans created inside it while it exists
+		are nested under it. Trace collects the spans of every thread and writes
+		them as a Chrome trace-event JSON file, which Perfetto (ui.perfetto.dev)
+		and chrome://tracing display as one flame graph per thread.
+
+		Spans are declared with the TRACE_SPAN macro, which is compiled out unless
+		SUBWAY_TRACE is defined, so a normal build pays nothing for them. In a
+		build with tracing, a span only records anything after Trace::start has
+		been called. Each thread appends its spans to a buffer of its own, so
+		recording takes no lock; the lock is only taken the first time a thread
+		records a span. Trace::write must not be called while spans are being
+		recorded.
+
+*******************************************************************************/
+
+class Trace {
+ public:
+	//	Starts recording spans, and makes now time 0 of the trace
+	static void start();
+
+	//	Returns true if spans are being recorded
+	static bool recording();
+
+	//	Stops recording and writes every recorded span to the file at path.
+	//	Returns false if the file cannot be written
+	static bool write(const std::string& path);
+
+	//	Returns the number of nanoseconds since start was called
+	static int64_t now();
+
+	//	Records a span named name, with detail shown as its argument, that
+	//	began at begin and lasted duration nanoseconds, for the calling thread
+	static void record(const char* name, const std::string& detail,
+										 int64_t begin, int64_t duration);
+
+ private:
+	//	A recorded span
+	struct Event {
+		const char* name;
+		std::string detail;
+		int64_t begin;
+		int64_t duration;
+	};
+
+	//	The spans recorded by one thread
+	struct Buffer {
+		unsigned int thread;
+		std::vector<Event> events;
+	};
+
+	//	Returns the calling thread's buffer, creating it the first time
+	static Buffer& buffer();
+
+	//	Protects buffers_
+	static std::mutex lock_;
+
+	//	The buffer of every thread that has recorded a span
+	static std::vector< std::unique_ptr<Buffer> > buffers_;
+};
+
+class TraceSpan {
+ public:
+	//	Begins a span named name, which must be a string that is never freed,
+	//	such as a literal. detail is shown as the span's argument
+	explicit TraceSpan(const char* name, const std::string& detail = "");
+
+	//	Ends the span and records it
+	~TraceSpan();
+
+ private:
+	TraceSpan(const TraceSpan&);
+	TraceSpan& operator=(const TraceSpan&);
+
+	//	The name and detail of the span, and when it began, or -1 if spans
+	//	were not being recorded then
+	const char* name_;
+	std::string detail_;
+	int64_t begin_;
+};
+
+#ifdef SUBWAY_TRACE
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SPAN(...) TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(__VA_ARGS__)
+#else
+#define TRACE_SPAN(...)
+#endif
+
+#endif
+
@@ -0,0 +1,330 @@
+/*******************************************************************************
+  Title          : track_index.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the TrackIndex class
+  Purpose        : To find the train line whose track passes closest to a
+									 point, and the closest point on that track
+  Usage          : Build a TrackIndex object from the SubwayLine objects of a
+									 SubwaySystem object and call closest_lines with a latitude
+									 and longitude point
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "track_index.h"
+#include "haversine.h"
+#include <algorithm>
+#include <functional>
+
+//	Number of segments for each empty slot when the index is packed again to
+//	make room
+static const unsigned int kSlack = 3;
+
+TrackIndex::TrackIndex() : x_scale_(0), y_scale_(0), segments_(), count_(0),
+    slots_(DEFAULT), free_(), boxes_(), levels_(1, 0)
+{
+}
+
+TrackIndex::~TrackIndex()
+{
+}
+
+void TrackIndex::build(const std::vector<const SubwayLine*>& lines) {
+	double latitudes = 0;
+	unsigned int count = 0;
+	for (auto& line : lines) {
+		for (auto& s : line->get_stations()) {
+			double lat, lon;
+			s.get_coordinates(lat, lon);
+			latitudes += lat;
+			++count;
+		}
+	}
+	y_scale_ = RA * TO_RAD;
+	x_scale_ = y_scale_ * cos(TO_RAD * (count ? latitudes / count : 0));
+
+	std::vector<Segment> segments;
+	for (auto& line : lines) {
+		int value = A;
+		while (value < DEFAULT && line->get_identifier() != (1UL << value)) {
+			++value;
+		}
+		for (auto& t : line->get_track()) {
+			segments.push_back(project(t, value));
+		}
+	}
+	pack(segments, 0);
+}
+
+void TrackIndex::update(int line, const std::vector<TrackSegment>& track) {
+	std::vector<Segment> added;
+	for (auto& t : track) {
+		added.push_back(project(t, line));
+	}
+
+	//	a segment of the old track that is also on the new one keeps its slot
+	std::vector<unsigned int>& slots = slots_[line];
+	std::vector<unsigned int> emptied;
+	for (unsigned int k = 0; k < slots.size(); ++k) {
+		const Segment& s = segments_[slots[k]];
+		unsigned int i = 0;
+		while (i < added.size() && 
+					 (s.x1 != added[i].x1 || s.y1 != added[i].y1 || 
+						s.x2 != added[i].x2 || s.y2 != added[i].y2)) {
+			++i;
+		}
+		if (i < added.size()) {
+			added.erase(added.begin() + i);
+		} else {
+			emptied.push_back(slots[k]);
+			slots.erase(slots.begin() + k--);
+		}
+	}
+	for (auto& slot : emptied) {
+		segments_[slot].line = -1;
+		free_.push_back(slot);
+		--count_;
+		refresh_path(slot);
+	}
+	if (added.size() > free_.size()) {
+		for (auto& s : segments_) {
+			if (s.line >= 0) {
+				added.push_back(s);
+			}
+		}
+		pack(added, kSlack);
+		return;
+	}
+
+	//	each new segment takes the empty slot whose leaf grows the least
+	for (auto& s : added) {
+		Box box = bound(s);
+		unsigned int best = 0;
+		double growth = HUGE_VAL;
+		for (unsigned int k = 0; k < free_.size() && levels_.size() > 2; ++k) {
+			const Box& leaf = boxes_[levels_[1] + free_[k] / kFanout];
+			double g = 0;
+			if (leaf.min_x <= leaf.max_x) {
+				g = (std::max(leaf.max_x, box.max_x) - std::min(leaf.min_x, box.min_x))
+						+ (std::max(leaf.max_y, box.max_y) - 
+							 std::min(leaf.min_y, box.min_y))
+						- (leaf.max_x - leaf.min_x) - (leaf.max_y - leaf.min_y);
+			}
+			if (g < growth) {
+				growth = g;
+				best = k;
+			}
+		}
+		unsigned int slot = free_[best];
+		free_[best] = free_.back();
+		free_.pop_back();
+		segments_[slot] = s;
+		slots.push_back(slot);
+		++count_;
+		refresh_path(slot);
+	}
+}
+
+bool TrackIndex::closest_lines(double latitude, double longitude,
+															 QueryScratch& scratch) const {
+	std::vector< std::pair<double, unsigned int> >& queue = scratch.queue;
+	std::greater< std::pair<double, unsigned int> > later;
+	scratch.lines = 0UL;
+	scratch.points.clear();
+	scratch.distance = HUGE_VAL;
+	if (count_ == 0) {
+		return false;
+	}
+	double x = longitude * x_scale_;
+	double y = latitude * y_scale_;
+	double px, py;
+
+	//	the root is the last box; a queued box's key is the squared distance to
+	//	it, and a queued segment's key is the exact squared distance to it
+	unsigned int top = levels_.size() - 2;
+	unsigned int root = boxes_.size() - 1;
+	queue.clear();
+	queue.push_back(std::make_pair((top == 0)
+																		 ? segment_distance(segments_[root], x, y,
+																												px, py)
+																		 : box_distance(boxes_[root], x, y),
+																 root));
+	double best = HUGE_VAL;
+	double closest_x[DEFAULT], closest_y[DEFAULT];
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), later);
+		std::pair<double, unsigned int> next = queue.back();
+		queue.pop_back();
+		if (next.first > best) {
+			//	everything left is farther than the closest segment, so the lines 
+			//	of every segment at the same distance have been found
+			break;
+		}
+		unsigned int i = next.second;
+		++scratch.probes;
+		if (i < levels_[1]) {
+			best = next.first;
+			int line = segments_[i].line;
+			if (!(scratch.lines & (1UL << line))) {
+				scratch.lines |= 1UL << line;
+				segment_distance(segments_[i], x, y, closest_x[line], 
+												 closest_y[line]);
+			}
+			continue;
+		}
+
+		unsigned int level = top;
+		while (i < levels_[level]) {
+			--level;
+		}
+		unsigned int first = levels_[level - 1] + (i - levels_[level]) * kFanout;
+		unsigned int last = std::min(first + kFanout, levels_[level]);
+		for (unsigned int c = first; c < last; ++c) {
+			if (boxes_[c].min_x > boxes_[c].max_x) {
+				continue;
+			}
+			double key = (level == 1) ? segment_distance(segments_[c], x, y, px, py)
+																: box_distance(boxes_[c], x, y);
+			if (key <= best) {
+				queue.push_back(std::make_pair(key, c));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+		}
+	}
+
+	for (int line = A; line < DEFAULT; ++line) {
+		if (scratch.lines & (1UL << line)) {
+			scratch.points.push_back(std::make_pair(closest_y[line] / y_scale_,
+																							closest_x[line] / x_scale_));
+		}
+	}
+	scratch.distance = haversine(latitude, longitude, scratch.points[0].first,
+															 scratch.points[0].second);
+	return true;
+}
+
+unsigned int TrackIndex::segments() const {
+	return count_;
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+TrackIndex::Segment TrackIndex::project(const TrackSegment& track, 
+																				int line) const {
+	Segment segment = { track.longitude1 * x_scale_, track.latitude1 * y_scale_,
+											track.longitude2 * x_scale_, track.latitude2 * y_scale_,
+											line };
+	return segment;
+}
+
+void TrackIndex::pack(std::vector<Segment>& segments, unsigned int slack) {
+	segments_.clear();
+	count_ = segments.size();
+	slots_.assign(DEFAULT, std::vector<unsigned int>());
+	free_.clear();
+	boxes_.clear();
+	levels_.assign(1, 0);
+	unsigned int n = segments.size();
+	if (n == 0) {
+		return;
+	}
+
+	//	sort-tile-recursive packing of the segments by their centers
+	unsigned int pages = (n + kFanout - 1) / kFanout;
+	unsigned int slices = (unsigned int)ceil(sqrt((double)pages));
+	unsigned int slice = slices * kFanout;
+	std::sort(segments.begin(), segments.end(),
+		[](const Segment& a, const Segment& b) {
+			return a.x1 + a.x2 < b.x1 + b.x2;
+		});
+	for (unsigned int i = 0; i < n; i += slice) {
+		std::sort(segments.begin() + i, segments.begin() + std::min(i + slice, n),
+			[](const Segment& a, const Segment& b) {
+				return a.y1 + a.y2 < b.y1 + b.y2;
+			});
+	}
+	for (unsigned int i = 0; i < n; ++i) {
+		slots_[segments[i].line].push_back(segments_.size());
+		segments_.push_back(segments[i]);
+		if (slack > 0 && i % slack == slack - 1) {
+			free_.push_back(segments_.size());
+			segments_.push_back(segments[i]);
+			segments_.back().line = -1;
+		}
+	}
+	for (auto& s : segments_) {
+		boxes_.push_back(bound(s));
+	}
+	levels_.push_back(segments_.size());
+
+	//	each level bounds kFanout consecutive boxes of the level below
+	while (levels_.back() - levels_[levels_.size() - 2] > 1) {
+		unsigned int first = levels_[levels_.size() - 2];
+		unsigned int last = levels_.back();
+		for (unsigned int i = first; i < last; i += kFanout) {
+			boxes_.push_back(bound(i, std::min(i + kFanout, last)));
+		}
+		levels_.push_back(boxes_.size());
+	}
+}
+
+void TrackIndex::refresh_path(unsigned int slot) {
+	boxes_[slot] = bound(segments_[slot]);
+	unsigned int i = slot;
+	for (unsigned int level = 1; level + 1 < levels_.size(); ++level) {
+		unsigned int k = (i - levels_[level - 1]) / kFanout;
+		unsigned int first = levels_[level - 1] + k * kFanout;
+		i = levels_[level] + k;
+		boxes_[i] = bound(first, std::min(first + kFanout, levels_[level]));
+	}
+}
+
+TrackIndex::Box TrackIndex::bound(const Segment& segment) {
+	if (segment.line < 0) {
+		Box empty = { HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+		return empty;
+	}
+	Box box = { std::min(segment.x1, segment.x2), 
+							std::min(segment.y1, segment.y2),
+							std::max(segment.x1, segment.x2), 
+							std::max(segment.y1, segment.y2) };
+	return box;
+}
+
+TrackIndex::Box TrackIndex::bound(unsigned int first, unsigned int last) const {
+	Box box = { HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+	for (unsigned int j = first; j < last; ++j) {
+		box.min_x = std::min(box.min_x, boxes_[j].min_x);
+		box.min_y = std::min(box.min_y, boxes_[j].min_y);
+		box.max_x = std::max(box.max_x, boxes_[j].max_x);
+		box.max_y = std::max(box.max_y, boxes_[j].max_y);
+	}
+	return box;
+}
+
+double TrackIndex::box_distance(const Box& box, double x, double y) {
+	double dx = std::max(std::max(box.min_x - x, x - box.max_x), 0.0);
+	double dy = std::max(std::max(box.min_y - y, y - box.max_y), 0.0);
+	return dx * dx + dy * dy;
+}
+
+double TrackIndex::segment_distance(const Segment& segment, double x, double y,
+																		double& px, double& py) {
+	double dx = segment.x2 - segment.x1;
+	double dy = segment.y2 - segment.y1;
+	double length = dx * dx + dy * dy;
+	double t = 0;
+	if (length > 0) {
+		t = ((x - segment.x1) * dx + (y - segment.y1) * dy) / length;
+		t = std::max(0.0, std::min(1.0, t));
+	}
+	px = segment.x1 + t * dx;
+	py = segment.y1 + t * dy;
+	return (x - px) * (x - px) + (y - py) * (y - py);
+}
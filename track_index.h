@@ -0,0 +1,151 @@
+/*******************************************************************************
+  Title          : track_index.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the TrackIndex class
+  Purpose        : To find the train line whose track passes closest to a
+									 point, and the closest point on that track
+  Usage          : Build a TrackIndex object from the SubwayLine objects of a
+									 SubwaySystem object and call closest_lines with a latitude
+									 and longitude point
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __TRACK_INDEX_H__
+#define __TRACK_INDEX_H__
+
+#include <vector>
+#include "subway_line.h"
+#include "query_scratch.h"
+
+/*******************************************************************************
+
+		The TrackIndex class is an R-tree of the TrackSegment objects of every
+		train line. The segments are projected onto a flat map in kilometers,
+		with the scale of longitude taken at the average latitude of the stations,
+		which is accurate to a fraction of a percent across New York City. The 
+		distance from a point to a line is the perpendicular distance to the 
+		closest of its segments on that map, or the distance to the closer end of
+		a segment if the perpendicular falls outside of it.
+
+		The tree is packed once when it is built, with the sort-tile-recursive 
+		method: the segments are sorted into vertical slices by the x coordinate 
+		of their centers, and each slice is sorted by the y coordinate, so that 
+		every kFanout consecutive segments lie close together. Each level of the 
+		tree stores the bounding box of kFanout consecutive boxes of the level 
+		below, and all levels are stored one after another in a single vector, so 
+		the tree needs no pointers. A query visits the boxes in order of their 
+		distance from the point, closest first, and stops when the closest box
+		left is farther than the closest segment found, so it reads a few 
+		branches of the tree instead of every segment. A built TrackIndex is 
+		never modified by a query, so any number of threads can query it at the
+		same time, as long as each thread uses its own QueryScratch object.
+
+		When the track of a line changes, update empties the slots of only the
+		segments that are not on the new track, shrinking the boxes above them,
+		and puts each new segment into the empty slot whose leaf box grows the
+		least, growing the boxes above it. The tree is packed again, with one
+		empty slot for every three segments, only when there are not enough 
+		empty slots left. The flat map keeps the scale it was built with.
+
+*******************************************************************************/
+
+class TrackIndex {
+ public:
+	//	Creates an empty TrackIndex object
+	TrackIndex();
+
+	//	Destroys TrackIndex object
+	~TrackIndex();
+
+	//	Builds the index of the tracks of lines, replacing the previous index, 
+	//	if any
+	void build(const std::vector<const SubwayLine*>& lines);
+
+	//	Replaces the segments of line, a LineValue, with those of track
+	void update(int line, const std::vector<TrackSegment>& track);
+
+	//	Sets scratch.lines to the line(s) whose track passes closest to the given
+	//	latitude and longitude point, scratch.points to the closest point on the
+	//	track of each of those lines, in the order of their LineValues, and 
+	//	scratch.distance to the distance in kilometers from the point to the
+	//	first of them. Adds the number of boxes and segments it visits to 
+	//	scratch.probes. Returns false if no line has a track
+	bool closest_lines(double latitude, double longitude,
+										 QueryScratch& scratch) const;
+
+	//	Returns the number of segments in the index
+	unsigned int segments() const;
+
+ private:
+	//	A rectangle on the flat map
+	struct Box {
+		double min_x;
+		double min_y;
+		double max_x;
+		double max_y;
+	};
+
+	//	A TrackSegment on the flat map, and the LineValue of its line, or -1 for
+	//	an empty slot
+	struct Segment {
+		double x1;
+		double y1;
+		double x2;
+		double y2;
+		int line;
+	};
+
+	//	Number of boxes grouped under each box of the level above
+	static const unsigned int kFanout = 8;
+
+	//	Kilometers per degree of longitude and of latitude on the flat map
+	double x_scale_;
+	double y_scale_;
+
+	//	The segments, in the order of the lowest level of the tree, and the 
+	//	number of slots that are not empty
+	std::vector<Segment> segments_;
+	unsigned int count_;
+
+	//	The slots of the segments of each line, and the empty slots
+	std::vector< std::vector<unsigned int> > slots_;
+	std::vector<unsigned int> free_;
+
+	//	The boxes of every level of the tree. The boxes of level k are boxes_[
+	//	levels_[k]] to boxes_[levels_[k + 1] - 1]; level 0 holds the bounding 
+	//	box of each segment, in the same order as segments_, and the last level
+	//	is the root
+	std::vector<Box> boxes_;
+	std::vector<unsigned int> levels_;
+
+	//	Returns track, a segment of line, on the flat map
+	Segment project(const TrackSegment& track, int line) const;
+
+	//	Packs the tree of segments, leaving an empty slot after every slack of
+	//	them if slack is not 0
+	void pack(std::vector<Segment>& segments, unsigned int slack);
+
+	//	Sets the box of slot, and every box above it, from what is under them
+	void refresh_path(unsigned int slot);
+
+	//	Returns the box of segment, whose minimums are above its maximums if 
+	//	its slot is empty
+	static Box bound(const Segment& segment);
+
+	//	Returns the box that bounds boxes_[first] to boxes_[last - 1]
+	Box bound(unsigned int first, unsigned int last) const;
+
+	//	Returns the squared distance from the point (x, y) to box
+	static double box_distance(const Box& box, double x, double y);
+
+	//	Returns the squared distance from the point (x, y) to segment, and sets
+	//	px and py to the closest point of segment
+	static double segment_distance(const Segment& segment, double x, double y,
+																 double& px, double& py);
+};
+
+#endif
+
@@ -0,0 +1,193 @@
+/*******************************************************************************
+  Title          : transfer_matrix.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the TransferMatrix class
+  Purpose        : To answer which train lines can be transferred between, and
+									 how many transfers it takes to get from one line to another
+  Usage          : Build a TransferMatrix object from a SubwaySystem object's
+									 stations and query it with LineValues
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "transfer_matrix.h"
+#include <algorithm>
+
+TransferMatrix::TransferMatrix() : stations_(DEFAULT * DEFAULT),
+    positions_(DEFAULT * DEFAULT), lines_() {
+	for (int i = A; i < DEFAULT; ++i) {
+		neighbors_[i] = 0UL;
+		for (int j = A; j < DEFAULT; ++j) {
+			transfers_[i][j] = (i == j) ? 0 : -1;
+			next_[i][j] = DEFAULT;
+			reachable_[i][j] = 1UL << i;
+		}
+	}
+}
+
+TransferMatrix::~TransferMatrix()
+{
+}
+
+void TransferMatrix::build(const std::vector<const SubwayStation*>& stations) {
+	*this = TransferMatrix();
+	lines_.resize(stations.size());
+	for (unsigned int p = 0; p < stations.size(); ++p) {
+		unsigned long lines = stations[p]->get_identifier();
+		lines_[p] = lines;
+		for (int i = A; i < DEFAULT; ++i) {
+			if (lines & (1UL << i)) {
+				for (int j = A; j < DEFAULT; ++j) {
+					if (j != i && (lines & (1UL << j))) {
+						stations_[i * DEFAULT + j].push_back(stations[p]);
+						positions_[i * DEFAULT + j].push_back(p);
+					}
+				}
+			}
+		}
+	}
+	connect();
+}
+
+void TransferMatrix::update(const std::vector<const SubwayStation*>& stations,
+														const std::vector<unsigned int>& changed) {
+	//	each list is sorted by position, so a station is found in it, or its
+	//	place is, by binary search
+	for (auto& p : changed) {
+		for (int add = 0; add < 2; ++add) {
+			unsigned long lines = 0UL;
+			if (!add && p < lines_.size()) {
+				lines = lines_[p];
+			} else if (add && p < stations.size()) {
+				lines = stations[p]->get_identifier();
+			}
+			for (int i = A; i < DEFAULT; ++i) {
+				for (int j = A; j < DEFAULT; ++j) {
+					if (j == i || !(lines & (1UL << i)) || !(lines & (1UL << j))) {
+						continue;
+					}
+					std::vector<unsigned int>& positions = positions_[i * DEFAULT + j];
+					std::vector<const SubwayStation*>& shared = 
+							stations_[i * DEFAULT + j];
+					unsigned int k = std::lower_bound(positions.begin(), 
+																						positions.end(), p) - 
+													 positions.begin();
+					if (add) {
+						positions.insert(positions.begin() + k, p);
+						shared.insert(shared.begin() + k, stations[p]);
+					} else {
+						positions.erase(positions.begin() + k);
+						shared.erase(shared.begin() + k);
+					}
+				}
+			}
+		}
+		if (p < stations.size()) {
+			if (lines_.size() <= p) {
+				lines_.resize(p + 1);
+			}
+			lines_[p] = stations[p]->get_identifier();
+		}
+	}
+	lines_.resize(stations.size());
+	connect();
+}
+
+void TransferMatrix::relink(const std::vector<const SubwayStation*>& stations) {
+	for (unsigned int k = 0; k < stations_.size(); ++k) {
+		for (unsigned int i = 0; i < stations_[k].size(); ++i) {
+			if (positions_[k][i] < stations.size()) {
+				stations_[k][i] = stations[positions_[k][i]];
+			}
+		}
+	}
+}
+
+unsigned long TransferMatrix::neighbors(int line) const {
+	return neighbors_[line];
+}
+
+int TransferMatrix::transfers(int from, int to) const {
+	return transfers_[from][to];
+}
+
+int TransferMatrix::next_line(int from, int to) const {
+	return next_[from][to];
+}
+
+unsigned long TransferMatrix::reachable(int line, unsigned int count) const {
+	if (count >= DEFAULT) {
+		count = DEFAULT - 1;
+	}
+	return reachable_[line][count];
+}
+
+const std::vector<const SubwayStation*>& TransferMatrix::stations(int from,
+																																	int to) const {
+	return stations_[from * DEFAULT + to];
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void TransferMatrix::connect() {
+	//	two lines can be transferred between where they share a station
+	for (int i = A; i < DEFAULT; ++i) {
+		neighbors_[i] = 0UL;
+		for (int j = A; j < DEFAULT; ++j) {
+			if (!stations_[i * DEFAULT + j].empty()) {
+				neighbors_[i] |= 1UL << j;
+			}
+			transfers_[i][j] = (i == j) ? 0 : -1;
+			next_[i][j] = DEFAULT;
+			reachable_[i][j] = 1UL << i;
+		}
+	}
+
+	//	breadth first search from every line, expanding a whole level of lines
+	//	at once: the lines reached with k + 1 transfers are the neighbors of the
+	//	lines reached with k transfers that were not reached before
+	for (int i = A; i < DEFAULT; ++i) {
+		unsigned long reached = 1UL << i;
+		unsigned long level = reached;
+		for (int k = 1; k < DEFAULT; ++k) {
+			unsigned long next_level = 0UL;
+			for (int j = A; j < DEFAULT; ++j) {
+				if (level & (1UL << j)) {
+					next_level |= neighbors_[j];
+				}
+			}
+			next_level &= ~reached;
+			reached |= next_level;
+			reachable_[i][k] = reached;
+			for (int j = A; j < DEFAULT; ++j) {
+				if (next_level & (1UL << j)) {
+					transfers_[i][j] = k;
+				}
+			}
+			level = next_level;
+		}
+	}
+
+	//	the first line to transfer to is a neighbor that is one transfer closer
+	//	to the destination
+	for (int i = A; i < DEFAULT; ++i) {
+		for (int j = A; j < DEFAULT; ++j) {
+			if (transfers_[i][j] <= 0) {
+				continue;
+			}
+			for (int n = A; n < DEFAULT; ++n) {
+				if ((neighbors_[i] & (1UL << n)) &&
+						transfers_[n][j] == transfers_[i][j] - 1) {
+					next_[i][j] = n;
+					break;
+				}
+			}
+		}
+	}
+}
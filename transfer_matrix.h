@@ -0,0 +1,126 @@
+/*******************************************************************************
+  Title          : transfer_matrix.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the TransferMatrix class
+  Purpose        : To answer which train lines can be transferred between, and
+									 how many transfers it takes to get from one line to another
+  Usage          : Build a TransferMatrix object from a SubwaySystem object's
+									 stations and query it with LineValues
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __TRANSFER_MATRIX_H__
+#define __TRANSFER_MATRIX_H__
+
+#include <vector>
+#include "subway_entrance.h"
+#include "subway_station.h"
+
+/*******************************************************************************
+
+		The TransferMatrix class stores everything there is to know about
+		transferring between the 26 train lines, computed once when it is built so
+		that every query takes constant time. Lines are given as LineValues and
+		sets of lines as 32-bit masks, like the identifier_ members of
+		SubwayStation objects.
+
+		A rider can transfer between two lines at any station that both of them
+		stop at. OR-ing the identifier_ masks of every station that a line stops
+		at therefore gives the mask of the lines it can be transferred to, and
+		those 26 masks form the transfer matrix. A breadth first search over the
+		matrix, one whole level of lines at a time, finds the fewest transfers
+		needed to get from every line to every other line, the first line to
+		transfer to on one such trip, and the lines that can be reached with at
+		most a given number of transfers. The stations where each pair of lines
+		can be transferred between are also kept.
+
+		When some of the stations change, update takes only them out of the 
+		lists of stations of the pairs of lines they served and puts the new 
+		ones into the lists of the pairs they serve. A pair of lines can be 
+		transferred between while its list is not empty, so the 26 masks are
+		read off the lists again, and the search over them, whose size does not
+		depend on the number of stations, is run again.
+
+*******************************************************************************/
+
+class TransferMatrix {
+ public:
+	//	Creates an empty TransferMatrix object, in which no line can be
+	//	transferred to
+	TransferMatrix();
+
+	//	Destroys TransferMatrix object
+	~TransferMatrix();
+
+	//	Builds the matrix from the stations of the subway system, replacing the
+	//	previous matrix, if any. The stations must exist for as long as the
+	//	matrix is used
+	void build(const std::vector<const SubwayStation*>& stations);
+
+	//	Brings the matrix up to date with stations after the stations at the 
+	//	positions in changed have been replaced, added or removed. A position 
+	//	in changed that is not less than the size of stations was removed. The
+	//	positions of the other stations must not have changed
+	void update(const std::vector<const SubwayStation*>& stations,
+							const std::vector<unsigned int>& changed);
+
+	//	Points the matrix at stations after the stations it holds have moved to 
+	//	other addresses. The stations at positions that are not less than the 
+	//	size of stations are left for the next update to remove
+	void relink(const std::vector<const SubwayStation*>& stations);
+
+	//	Returns the mask of the lines that line can be transferred to directly,
+	//	not including line itself
+	unsigned long neighbors(int line) const;
+
+	//	Returns the fewest transfers needed to get from line from to line to, or
+	//	-1 if it cannot be reached
+	int transfers(int from, int to) const;
+
+	//	Returns the line to transfer to first on a trip from line from to line
+	//	to with the fewest transfers, or DEFAULT if to is from or cannot be
+	//	reached. When there are several, the one with the lowest LineValue is
+	//	chosen
+	int next_line(int from, int to) const;
+
+	//	Returns the mask of the lines that can be reached from line with at most
+	//	count transfers, including line itself
+	unsigned long reachable(int line, unsigned int count) const;
+
+	//	Returns the stations where line from and line to can be transferred
+	//	between, in the order of their positions in the vector given to build
+	const std::vector<const SubwayStation*>& stations(int from, int to) const;
+
+ private:
+	//	neighbors_[i] is the mask of the lines that line i can be transferred to
+	unsigned long neighbors_[DEFAULT];
+
+	//	transfers_[i][j] is the fewest transfers from line i to line j, or -1
+	signed char transfers_[DEFAULT][DEFAULT];
+
+	//	next_[i][j] is the first line to transfer to from line i on the way to
+	//	line j, or DEFAULT
+	unsigned char next_[DEFAULT][DEFAULT];
+
+	//	reachable_[i][k] is the mask of the lines reachable from line i with at
+	//	most k transfers. No line is more than DEFAULT - 1 transfers away
+	unsigned long reachable_[DEFAULT][DEFAULT];
+
+	//	The stations shared by each pair of lines, at index i * DEFAULT + j, 
+	//	and their positions
+	std::vector< std::vector<const SubwayStation*> > stations_;
+	std::vector< std::vector<unsigned int> > positions_;
+
+	//	The mask of the lines of the station at each position
+	std::vector<unsigned long> lines_;
+
+	//	Sets neighbors_ from the lists of stations, and every other table from
+	//	neighbors_
+	void connect();
+};
+
+#endif
+
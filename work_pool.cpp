@@ -0,0 +1,198 @@
+/*******************************************************************************
+  Title          : work_pool.cpp
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The implementation file for the WorkPool class
+  Purpose        : To run independent pieces of work on several threads
+  Usage          : Create a WorkPool object, submit tasks to it or give it a
+									 range of indices with parallel_for, and call wait to block
+									 until all the work is done
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#include "work_pool.h"
+#include "alloc_stats.h"
+
+//	The pool that the current thread works for, if any, and its worker number
+static thread_local const WorkPool* current_pool = nullptr;
+static thread_local unsigned int current_worker = 0;
+
+WorkPool::WorkPool(unsigned int threads) : queues_(), threads_(),
+    state_lock_(), work_available_(), all_done_(), queued_(0), unfinished_(0),
+    next_queue_(0), stopping_(false) {
+	if (threads == 0) {
+		threads = std::thread::hardware_concurrency();
+	}
+	if (threads == 0) {
+		threads = 1;
+	}
+	for (unsigned int i = 0; i < threads; ++i) {
+		queues_.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+	}
+	for (unsigned int i = 0; i < threads; ++i) {
+		threads_.push_back(std::thread(&WorkPool::run, this, i));
+	}
+}
+
+WorkPool::~WorkPool() {
+	wait();
+	{
+		std::lock_guard<std::mutex> guard(state_lock_);
+		stopping_ = true;
+	}
+	work_available_.notify_all();
+	for (auto& t : threads_) {
+		t.join();
+	}
+}
+
+void WorkPool::submit(const Task& task) {
+	unsigned int queue;
+	if (current_pool == this) {
+		queue = current_worker;
+	} else {
+		queue = next_queue_++ % queues_.size();
+	}
+	++unfinished_;
+	{
+		//	counted before it is queued so that queued_ never drops below the 
+		//	number of tasks in the queues
+		std::lock_guard<std::mutex> guard(state_lock_);
+		++queued_;
+	}
+	{
+		std::lock_guard<std::mutex> guard(queues_[queue]->lock);
+		QueuedTask queued = { task, AllocStats::current() };
+		queues_[queue]->tasks.push_back(std::move(queued));
+	}
+	work_available_.notify_one();
+}
+
+void WorkPool::parallel_for(unsigned int begin, unsigned int end,
+														unsigned int grain, const RangeTask& task) {
+	if (begin >= end) {
+		return;
+	}
+	if (grain == 0) {
+		grain = 1;
+	}
+
+	//	the pieces share a counter so that this call can wait for its own pieces
+	//	without waiting for unrelated tasks
+	struct Pieces {
+		std::atomic<unsigned int> remaining;
+		std::mutex lock;
+		std::condition_variable finished;
+	};
+	std::shared_ptr<Pieces> pieces(new Pieces());
+	pieces->remaining = (end - begin + grain - 1) / grain;
+
+	for (unsigned int first = begin; first < end; first += grain) {
+		unsigned int last = (end - first > grain) ? first + grain : end;
+		submit([pieces, &task, first, last](unsigned int worker) {
+			task(worker, first, last);
+			if (--pieces->remaining == 0) {
+				std::lock_guard<std::mutex> guard(pieces->lock);
+				pieces->finished.notify_all();
+			}
+		});
+	}
+
+	if (current_pool == this) {
+		//	a worker cannot sleep here without starving its own queue, so it runs
+		//	queued tasks until all of its pieces are done
+		Task next;
+		unsigned int scope;
+		while (pieces->remaining != 0) {
+			if (take(current_worker, next, scope)) {
+				finish(current_worker, next, scope);
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	} else {
+		std::unique_lock<std::mutex> guard(pieces->lock);
+		pieces->finished.wait(guard, [&pieces]() {
+			return pieces->remaining == 0;
+		});
+	}
+}
+
+void WorkPool::wait() {
+	std::unique_lock<std::mutex> guard(state_lock_);
+	all_done_.wait(guard, [this]() { return unfinished_ == 0; });
+}
+
+unsigned int WorkPool::size() const {
+	return threads_.size();
+}
+
+/*******************************************************************************
+
+																		PRIVATE
+
+*******************************************************************************/
+
+void WorkPool::run(unsigned int worker) {
+	current_pool = this;
+	current_worker = worker;
+	Task task;
+	unsigned int scope;
+	while (true) {
+		if (take(worker, task, scope)) {
+			finish(worker, task, scope);
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(state_lock_);
+		work_available_.wait(guard, [this]() {
+			return stopping_ || queued_ != 0;
+		});
+		if (stopping_ && queued_ == 0) {
+			return;
+		}
+	}
+}
+
+bool WorkPool::take(unsigned int worker, Task& task, unsigned int& scope) {
+	//	newest task from this worker's own queue
+	{
+		TaskQueue& own = *queues_[worker];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (!own.tasks.empty()) {
+			task = std::move(own.tasks.back().task);
+			scope = own.tasks.back().scope;
+			own.tasks.pop_back();
+			--queued_;
+			return true;
+		}
+	}
+	//	oldest task from the next worker that has one
+	for (unsigned int i = 1; i < queues_.size(); ++i) {
+		TaskQueue& other = *queues_[(worker + i) % queues_.size()];
+		std::lock_guard<std::mutex> guard(other.lock);
+		if (!other.tasks.empty()) {
+			task = std::move(other.tasks.front().task);
+			scope = other.tasks.front().scope;
+			other.tasks.pop_front();
+			--queued_;
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkPool::finish(unsigned int worker, Task& task, unsigned int scope) {
+	{
+		//	the task is destroyed in its scope too, so what it frees is counted
+		//	where it was allocated
+		AllocScope in_scope(scope, false);
+		task(worker);
+		task = Task();
+	}
+	if (--unfinished_ == 0) {
+		std::lock_guard<std::mutex> guard(state_lock_);
+		all_done_.notify_all();
+	}
+}
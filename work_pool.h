@@ -0,0 +1,137 @@
+/*******************************************************************************
+  Title          : work_pool.h
+  Author         : Lashana Tello
+  Created on     : October 19, 2026
+  Description    : The interface file for the WorkPool class
+  Purpose        : To run independent pieces of work on several threads
+  Usage          : Create a WorkPool object, submit tasks to it or give it a
+									 range of indices with parallel_for, and call wait to block
+									 until all the work is done
+  Build with     : No building
+  Modifications  :
+
+*******************************************************************************/
+
+#ifndef __WORK_POOL_H__
+#define __WORK_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+
+		The WorkPool class is a fixed-size pool of worker threads that share work
+		by stealing it from each other. Every worker owns a queue of tasks. A
+		worker takes new tasks from the back of its own queue, and when its queue
+		is empty it steals the oldest task from the front of another worker's
+		queue, so workers that finish early take over the work of workers that are
+		behind. Tasks submitted by a worker go to that worker's own queue and tasks
+		submitted by any other thread are spread over the queues in turn.
+
+		Each task is given the number of the worker that runs it, which is always
+		less than size(). This lets callers keep one piece of scratch storage per
+		worker, such as a QueryScratch object, instead of one per task. Idle
+		workers sleep until a task is submitted. A task runs in the AllocStats
+		scope that was current when it was submitted, so its allocations are
+		counted where the work came from.
+
+*******************************************************************************/
+
+class WorkPool {
+ public:
+	//	A piece of work. Its argument is the number of the worker that runs it
+	typedef std::function<void(unsigned int)> Task;
+
+	//	A piece of work over the indices [first, last). Its first argument is the
+	//	number of the worker that runs it
+	typedef std::function<void(unsigned int, unsigned int, unsigned int)>
+			RangeTask;
+
+	//	Creates a WorkPool object with the given number of worker threads. If
+	//	threads is 0, one worker is created per hardware thread
+	explicit WorkPool(unsigned int threads = 0);
+
+	//	Waits for all submitted tasks to finish and destroys WorkPool object
+	~WorkPool();
+
+	//	Queues task to be run by one of the workers
+	void submit(const Task& task);
+
+	//	Splits the indices [begin, end) into pieces of at most grain indices,
+	//	runs task on every piece and waits until all of them have finished. When
+	//	called from inside a task, the calling worker runs queued tasks while it
+	//	waits
+	void parallel_for(unsigned int begin, unsigned int end, unsigned int grain,
+										const RangeTask& task);
+
+	//	Blocks until every submitted task has finished. Must not be called from
+	//	inside a task
+	void wait();
+
+	//	Returns the number of worker threads
+	unsigned int size() const;
+
+ private:
+	//	A queued task and the AllocStats scope it was submitted in
+	struct QueuedTask {
+		Task task;
+		unsigned int scope;
+	};
+
+	//	A worker's queue of tasks and the lock that protects it
+	struct TaskQueue {
+		std::mutex lock;
+		std::deque<QueuedTask> tasks;
+	};
+
+	WorkPool(const WorkPool&);
+	WorkPool& operator=(const WorkPool&);
+
+	//	One queue per worker
+	std::vector< std::unique_ptr<TaskQueue> > queues_;
+
+	//	The worker threads
+	std::vector<std::thread> threads_;
+
+	//	Protects the sleeping and waiting conditions below
+	std::mutex state_lock_;
+
+	//	Signaled when a task is queued or the pool is stopping
+	std::condition_variable work_available_;
+
+	//	Signaled when the last unfinished task finishes
+	std::condition_variable all_done_;
+
+	//	Number of tasks that are queued but have not started
+	std::atomic<unsigned int> queued_;
+
+	//	Number of tasks that have been submitted but have not finished
+	std::atomic<unsigned int> unfinished_;
+
+	//	Queue that receives the next task submitted from outside the pool
+	std::atomic<unsigned int> next_queue_;
+
+	//	True when the workers should exit
+	bool stopping_;
+
+	//	The loop run by each worker thread
+	void run(unsigned int worker);
+
+	//	Takes a task and the scope it was submitted in from worker's own queue,
+	//	or steals them from another queue. Returns false if every queue is empty
+	bool take(unsigned int worker, Task& task, unsigned int& scope);
+
+	//	Runs task, which was submitted in scope, on worker in that scope and 
+	//	marks it finished
+	void finish(unsigned int worker, Task& task, unsigned int scope);
+};
+
+#endif
+